@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fbjni/ColumnarBatch.h>
+
+namespace facebook {
+namespace jni {
+
+local_ref<JColumnarBatch> JColumnarBatch::create(
+    jint rowCount,
+    alias_ref<JArrayClass<jstring>> names,
+    alias_ref<JArrayClass<jobject>> columns) {
+  return newInstance(rowCount, names, columns);
+}
+
+jint JColumnarBatch::getRowCount() const {
+  static const auto method =
+      javaClassStatic()->getMethod<jint()>("getRowCount");
+  return method(self());
+}
+
+local_ref<jobject> JColumnarBatch::getColumn(const char* name) const {
+  static const auto method =
+      javaClassStatic()->getMethod<jobject(alias_ref<JString>)>("getColumn");
+  return method(self(), make_jstring(name));
+}
+
+local_ref<JArrayClass<jobject>> JColumnarBatch::newObjects(
+    alias_ref<JClass> type,
+    alias_ref<JRowFactory> factory) const {
+  static const auto method =
+      javaClassStatic()
+          ->getMethod<JArrayClass<jobject>::javaobject(
+              alias_ref<JClass>, alias_ref<JRowFactory>)>("newObjects");
+  return method(self(), type, factory);
+}
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook {
+namespace jni {
+
+/**
+ * com.facebook.jni.ColumnarBatch: rows of records stored as one array per
+ * field.
+ */
+class JColumnarBatch : public JavaClass<JColumnarBatch> {
+ public:
+  static constexpr const char* kJavaDescriptor =
+      "Lcom/facebook/jni/ColumnarBatch;";
+
+  /// com.facebook.jni.ColumnarBatch$RowFactory, which creates the object for
+  /// one row.
+  struct JRowFactory : JavaClass<JRowFactory> {
+    static constexpr const char* kJavaDescriptor =
+        "Lcom/facebook/jni/ColumnarBatch$RowFactory;";
+  };
+
+  static local_ref<JColumnarBatch> create(
+      jint rowCount,
+      alias_ref<JArrayClass<jstring>> names,
+      alias_ref<JArrayClass<jobject>> columns);
+
+  jint getRowCount() const;
+
+  /// Returns the column with the given name. Throws IllegalArgumentException
+  /// if there isn't one.
+  local_ref<jobject> getColumn(const char* name) const;
+
+  /// Creates one object per row in a single call into Java, with factory. The
+  /// returned array's runtime type is type[].
+  local_ref<JArrayClass<jobject>> newObjects(
+      alias_ref<JClass> type,
+      alias_ref<JRowFactory> factory) const;
+};
+
+/**
+ * Describes one field of a record type, for Columns.
+ */
+template <typename Record, typename Field>
+struct Column {
+  const char* name;
+  Field Record::*member;
+};
+
+template <typename Record, typename Field>
+constexpr Column<Record, Field> column(
+    const char* name,
+    Field Record::*member) {
+  return Column<Record, Field>{name, member};
+}
+
+namespace detail {
+
+template <size_t Size>
+struct SignedJniInteger;
+template <>
+struct SignedJniInteger<1> {
+  using type = jbyte;
+};
+template <>
+struct SignedJniInteger<2> {
+  using type = jshort;
+};
+template <>
+struct SignedJniInteger<4> {
+  using type = jint;
+};
+template <>
+struct SignedJniInteger<8> {
+  using type = jlong;
+};
+
+// Maps a field type to the primitive type of its column. Integers map to the
+// Java type of the same size (unsigned values keep their bits), and enums are
+// stored as their underlying type.
+template <typename T, typename Enable = void>
+struct ColumnType {
+  static_assert(
+      std::is_same<T, void>::value,
+      "Column fields must be bool, integers, enums, floating point or "
+      "std::string");
+};
+
+template <>
+struct ColumnType<bool> {
+  using type = jboolean;
+};
+
+template <>
+struct ColumnType<float> {
+  using type = jfloat;
+};
+
+template <>
+struct ColumnType<double> {
+  using type = jdouble;
+};
+
+template <typename T>
+struct ColumnType<
+    T,
+    typename std::enable_if<
+        std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  using type = typename SignedJniInteger<sizeof(T)>::type;
+};
+
+template <typename T>
+struct ColumnType<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+  using type =
+      typename ColumnType<typename std::underlying_type<T>::type>::type;
+};
+
+template <typename Field, typename J>
+typename std::enable_if<!std::is_enum<Field>::value, Field>::type
+fromColumnValue(J value) {
+  return static_cast<Field>(value);
+}
+
+// Goes through the underlying type, so that unsigned values stored in a signed
+// column come back unchanged.
+template <typename Field, typename J>
+typename std::enable_if<std::is_enum<Field>::value, Field>::type
+fromColumnValue(J value) {
+  return static_cast<Field>(
+      static_cast<typename std::underlying_type<Field>::type>(value));
+}
+
+template <typename Record, typename Field>
+local_ref<jobject> writeColumn(
+    const Column<Record, Field>& column,
+    const Record* records,
+    size_t count) {
+  using J = typename ColumnType<Field>::type;
+  using ArrayType = typename jtype_traits<J>::array_type;
+  std::vector<J> values(count);
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = static_cast<J>(records[i].*column.member);
+  }
+  auto array = JPrimitiveArray<ArrayType>::newArray(count);
+  if (count > 0) {
+    array->setRegion(0, static_cast<jsize>(count), values.data());
+  }
+  return array;
+}
+
+template <typename Record>
+local_ref<jobject> writeColumn(
+    const Column<Record, std::string>& column,
+    const Record* records,
+    size_t count) {
+  StringJoiner strings(count);
+  for (size_t i = 0; i < count; ++i) {
+    strings.add(records[i].*column.member);
+  }
+  return toJavaStringArray(strings);
+}
+
+template <typename Record, typename Field>
+void readColumn(
+    const Column<Record, Field>& column,
+    alias_ref<JColumnarBatch> batch,
+    std::vector<Record>& records) {
+  using J = typename ColumnType<Field>::type;
+  using ArrayType = typename jtype_traits<J>::array_type;
+  auto array = dynamic_ref_cast<JPrimitiveArray<ArrayType>>(
+      batch->getColumn(column.name));
+  std::vector<J> values(records.size());
+  if (!values.empty()) {
+    array->getRegion(0, static_cast<jsize>(values.size()), values.data());
+  }
+  for (size_t i = 0; i < values.size(); ++i) {
+    records[i].*column.member = fromColumnValue<Field>(values[i]);
+  }
+}
+
+template <typename Record>
+void readColumn(
+    const Column<Record, std::string>& column,
+    alias_ref<JColumnarBatch> batch,
+    std::vector<Record>& records) {
+  auto strings = toStringVector(
+      dynamic_ref_cast<JArrayClass<jstring>>(batch->getColumn(column.name)));
+  for (size_t i = 0; i < records.size(); ++i) {
+    records[i].*column.member = std::move(strings[i]);
+  }
+}
+
+} // namespace detail
+
+/**
+ * Moves records between C++ and Java as columns: one Java array per field,
+ * each written or read with a single Set<Type>ArrayRegion or
+ * Get<Type>ArrayRegion call, instead of one Java object per record. Describe
+ * the fields once:
+ *
+ * struct Sample {
+ *   int64_t timestamp;
+ *   double value;
+ *   std::string label;
+ * };
+ *
+ * static const auto kSampleColumns = makeColumns(
+ *     column("timestamp", &Sample::timestamp),
+ *     column("value", &Sample::value),
+ *     column("label", &Sample::label));
+ *
+ * and then convert whole vectors of records:
+ *
+ * local_ref<JColumnarBatch> batch = kSampleColumns.toJava(samples);
+ * std::vector<Sample> samples = kSampleColumns.fromJava(batch);
+ *
+ * In Java, ColumnarBatch gives access to the columns by name, for example
+ * batch.getLongColumn("timestamp"). Primitive fields cost one array per column
+ * whatever the number of rows. String fields are joined into one string per
+ * column and split on the Java side, so they also cost a constant number of
+ * JNI calls, plus the Java work of creating each String.
+ *
+ * fromJava requires Record to be default constructible, and reads columns by
+ * name, so a batch built in Java may hold extra columns or list them in any
+ * order.
+ *
+ * newObjects builds one Java object per record instead of a batch, without a
+ * JNI call per object: the columns are sent as above and a single Java call
+ * hands each row to a ColumnarBatch.RowFactory, which reads the row's values
+ * out of the typed columns and constructs the object:
+ *
+ * local_ref<JArrayClass<JSample::javaobject>> objects =
+ *     kSampleColumns.newObjects<JSample>(factory, samples);
+ */
+template <typename Record, typename... Fields>
+class Columns {
+ public:
+  constexpr explicit Columns(Column<Record, Fields>... columns)
+      : columns_(columns...) {}
+
+  local_ref<JColumnarBatch> toJava(const Record* records, size_t count) const {
+    return toJava(records, count, std::index_sequence_for<Fields...>());
+  }
+
+  local_ref<JColumnarBatch> toJava(const std::vector<Record>& records) const {
+    return toJava(records.data(), records.size());
+  }
+
+  template <typename T>
+  local_ref<JArrayClass<typename T::javaobject>> newObjects(
+      alias_ref<JColumnarBatch::JRowFactory> factory,
+      const Record* records,
+      size_t count) const {
+    using ArrayType = typename JArrayClass<typename T::javaobject>::javaobject;
+    auto objects =
+        toJava(records, count)->newObjects(T::javaClassStatic(), factory);
+    return adopt_local(
+        static_cast<ArrayType>(static_cast<jobject>(objects.release())));
+  }
+
+  template <typename T>
+  local_ref<JArrayClass<typename T::javaobject>> newObjects(
+      alias_ref<JColumnarBatch::JRowFactory> factory,
+      const std::vector<Record>& records) const {
+    return newObjects<T>(factory, records.data(), records.size());
+  }
+
+  std::vector<Record> fromJava(alias_ref<JColumnarBatch> batch) const {
+    std::vector<Record> records(batch->getRowCount());
+    fromJava(batch, records, std::index_sequence_for<Fields...>());
+    return records;
+  }
+
+ private:
+  template <size_t... Is>
+  local_ref<JColumnarBatch> toJava(
+      const Record* records,
+      size_t count,
+      std::index_sequence<Is...>) const {
+    auto names = JArrayClass<jstring>::newArray(sizeof...(Fields));
+    auto columns = JArrayClass<jobject>::newArray(sizeof...(Fields));
+    // Each column's array is released as soon as it is stored, so wide
+    // records don't pile up local references.
+    (void)std::initializer_list<int>{
+        (names->setElement(
+             Is, make_jstring(std::get<Is>(columns_).name).get()),
+         columns->setElement(
+             Is,
+             detail::writeColumn(std::get<Is>(columns_), records, count)
+                 .get()),
+         0)...};
+    return JColumnarBatch::create(static_cast<jint>(count), names, columns);
+  }
+
+  template <size_t... Is>
+  void fromJava(
+      alias_ref<JColumnarBatch> batch,
+      std::vector<Record>& records,
+      std::index_sequence<Is...>) const {
+    (void)std::initializer_list<int>{
+        (detail::readColumn(std::get<Is>(columns_), batch, records), 0)...};
+  }
+
+  std::tuple<Column<Record, Fields>...> columns_;
+};
+
+template <typename Record, typename... Fields>
+constexpr Columns<Record, Fields...> makeColumns(
+    Column<Record, Fields>... columns) {
+  return Columns<Record, Fields...>(columns...);
+}
+
+} // namespace jni
+} // namespace facebook
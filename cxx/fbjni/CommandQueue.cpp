@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fbjni/CommandQueue.h>
+
+#include <string>
+
+namespace facebook {
+namespace jni {
+
+namespace {
+
+constexpr size_t kCommandHeaderSize = 2 * sizeof(int32_t);
+
+int32_t readInt(const uint8_t* data) {
+  int32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+} // namespace
+
+local_ref<JCommandQueue::jhybridobject> JCommandQueue::create(
+    size_t capacity) {
+  return newObjectCxxArgs(capacity);
+}
+
+void JCommandQueue::OnLoad() {
+  registerHybrid({
+      makeNativeMethod("nativeGetBuffer", JCommandQueue::getBuffer),
+      makeNativeMethod("nativeFlush", JCommandQueue::flush),
+  });
+}
+
+local_ref<JByteBuffer> JCommandQueue::getBuffer() {
+  return JByteBuffer::wrapBytes(buffer_.get(), capacity_);
+}
+
+void JCommandQueue::flush(jint size) {
+  if (size < 0 || static_cast<size_t>(size) > capacity_) {
+    throw std::out_of_range("Invalid command queue size");
+  }
+  const uint8_t* data = buffer_.get();
+  const uint8_t* end = data + size;
+  while (data != end) {
+    if (static_cast<size_t>(end - data) < kCommandHeaderSize) {
+      throw std::out_of_range("Truncated command");
+    }
+    int32_t opcode = readInt(data);
+    int32_t length = readInt(data + sizeof(int32_t));
+    data += kCommandHeaderSize;
+    if (length < 0 || length > end - data) {
+      throw std::out_of_range("Truncated command");
+    }
+    if (opcode < 0 || static_cast<size_t>(opcode) >= handlers_.size() ||
+        !handlers_[opcode]) {
+      throw std::invalid_argument(
+          "No handler for opcode " + std::to_string(opcode));
+    }
+    CommandReader reader(data, length);
+    handlers_[opcode](reader);
+    if (reader.remaining() != 0) {
+      throw std::invalid_argument(
+          "Handler for opcode " + std::to_string(opcode) + " left " +
+          std::to_string(reader.remaining()) + " bytes unread");
+    }
+    data += length;
+  }
+}
+
+} // namespace jni
+} // namespace facebook
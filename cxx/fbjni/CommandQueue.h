@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/ByteBuffer.h>
+#include <fbjni/fbjni.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook {
+namespace jni {
+
+/**
+ * Reads the arguments of one command from a CommandQueue, in the order the
+ * Java side wrote them.
+ */
+class CommandReader {
+ public:
+  CommandReader(const uint8_t* data, size_t size)
+      : data_(data), remaining_(size) {}
+
+  /// T is an arithmetic type, written in Java with the put method for the
+  /// Java type of the same size. bool is read as a jboolean.
+  template <typename T>
+  T read() {
+    static_assert(
+        std::is_arithmetic<T>::value, "Commands may only hold primitives");
+    using Stored =
+        typename std::conditional<std::is_same<T, bool>::value, jboolean, T>::
+            type;
+    if (remaining_ < sizeof(Stored)) {
+      throw std::out_of_range("Read past the end of a command");
+    }
+    Stored value;
+    std::memcpy(&value, data_, sizeof(Stored));
+    data_ += sizeof(Stored);
+    remaining_ -= sizeof(Stored);
+    return static_cast<T>(value);
+  }
+
+  size_t remaining() const {
+    return remaining_;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t remaining_;
+};
+
+/**
+ * com.facebook.jni.CommandQueue: lets Java make many small calls into C++ for
+ * the cost of one. Java appends commands (an opcode and primitive arguments)
+ * to a direct ByteBuffer over memory owned by the queue's native part, and
+ * each flush() runs every queued command with a single JNI call. Native code
+ * creates the queue and registers a typed handler for each opcode:
+ *
+ * auto queue = JCommandQueue::create(64 * 1024);
+ * queue->cthis()->on<jint, jfloat, jfloat>(
+ *     kMoveTo,
+ *     [view](jint id, jfloat x, jfloat y) { view->moveTo(id, x, y); });
+ * return queue;
+ *
+ * and Java writes commands with the arguments in the same order:
+ *
+ * queue.begin(MOVE_TO).putInt(id).putFloat(x).putFloat(y).end();
+ * ...
+ * queue.flush();
+ *
+ * Each command costs a few bytes of buffer space and a call through an
+ * std::function, and the queue flushes itself when it fills up. With N
+ * commands per flush, a command costs about (cost of a native call) / N plus
+ * its decoding and dispatch, instead of a full native call.
+ *
+ * Handlers run on the thread that calls flush(). An exception thrown by a
+ * handler is rethrown from flush() in Java, and the rest of the batch is
+ * discarded.
+ */
+class JCommandQueue : public HybridClass<JCommandQueue> {
+ public:
+  static constexpr auto kJavaDescriptor = "Lcom/facebook/jni/CommandQueue;";
+
+  /// Each command takes 8 bytes plus its arguments, so capacity must be
+  /// large enough for the largest command.
+  static local_ref<jhybridobject> create(size_t capacity);
+
+  explicit JCommandQueue(size_t capacity)
+      : capacity_(capacity), buffer_(new uint8_t[capacity]) {}
+
+  static void OnLoad();
+
+  /// Calls handler for each command with the given opcode, passing the
+  /// command's arguments read as Args. Opcodes are small non-negative
+  /// integers; registering an opcode again replaces its handler.
+  template <typename... Args, typename F>
+  void on(jint opcode, F handler) {
+    if (opcode < 0) {
+      throw std::invalid_argument("Opcodes must not be negative");
+    }
+    if (static_cast<size_t>(opcode) >= handlers_.size()) {
+      handlers_.resize(opcode + 1);
+    }
+    handlers_[opcode] = [handler](CommandReader& reader) mutable {
+      // Braced initialization reads the arguments in order.
+      std::tuple<Args...> args{reader.template read<Args>()...};
+      call(handler, args, std::index_sequence_for<Args...>());
+    };
+  }
+
+ private:
+  template <typename F, typename Tuple, size_t... Is>
+  static void call(F& handler, Tuple& args, std::index_sequence<Is...>) {
+    handler(std::get<Is>(args)...);
+  }
+
+  local_ref<JByteBuffer> getBuffer();
+  void flush(jint size);
+
+  const size_t capacity_;
+  const std::unique_ptr<uint8_t[]> buffer_;
+  std::vector<std::function<void(CommandReader&)>> handlers_;
+};
+
+} // namespace jni
+} // namespace facebook
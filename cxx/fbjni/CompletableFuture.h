@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#ifndef FBJNI_NO_EXCEPTION_PTR
+#include <exception>
+#include <future>
+#include <stdexcept>
+#endif
+
+namespace facebook {
+namespace jni {
+
+struct JBiConsumer : public JavaClass<JBiConsumer> {
+  static auto constexpr kJavaDescriptor = "Ljava/util/function/BiConsumer;";
+};
+
+struct JNativeBiConsumer
+    : public HybridClass<JNativeBiConsumer, JBiConsumer> {
+ public:
+  static auto constexpr kJavaDescriptor =
+      "Lcom/facebook/jni/NativeBiConsumer;";
+
+  using Callback =
+      std::function<void(alias_ref<jobject>, alias_ref<jobject>)>;
+
+  JNativeBiConsumer(Callback&& callback) : callback_(std::move(callback)) {}
+
+  static void OnLoad() {
+    // java.util.function only exists from Android API level 24. Without it
+    // there is nothing to register, and JCompletableFuture::whenComplete
+    // can't be used.
+    try {
+      registerHybrid({
+          makeNativeMethod("accept", JNativeBiConsumer::accept),
+      });
+    } catch (const JniException&) {
+    }
+  }
+
+  void accept(alias_ref<jobject> t, alias_ref<jobject> u) {
+    callback_(t, u);
+  }
+
+ private:
+  Callback callback_;
+};
+
+#ifndef FBJNI_NO_EXCEPTION_PTR
+template <typename T>
+class NativePromise;
+#endif
+
+/**
+ * Wrapper for java.util.concurrent.CompletableFuture. Completion callbacks are
+ * implemented with com.facebook.jni.NativeBiConsumer, a java.util.function
+ * type, so on Android these need API level 24.
+ */
+template <typename T = jobject>
+struct JCompletableFuture : JavaClass<JCompletableFuture<T>> {
+  constexpr static auto kJavaDescriptor =
+      "Ljava/util/concurrent/CompletableFuture;";
+
+  using Base = JavaClass<JCompletableFuture<T>>;
+  using javaobject = typename Base::javaobject;
+
+  using Callback =
+      std::function<void(alias_ref<T> value, alias_ref<JThrowable> error)>;
+
+  static local_ref<javaobject> create() {
+    return Base::newInstance();
+  }
+
+  bool complete(alias_ref<T> value) const {
+    static const auto method =
+        Base::javaClassStatic()->template getMethod<jboolean(
+            alias_ref<jobject>)>("complete");
+    return method(this->self(), value);
+  }
+
+  bool completeExceptionally(alias_ref<JThrowable> error) const {
+    static const auto method =
+        Base::javaClassStatic()->template getMethod<jboolean(
+            alias_ref<JThrowable>)>("completeExceptionally");
+    return method(this->self(), error);
+  }
+
+  bool isDone() const {
+    static const auto method =
+        Base::javaClassStatic()->template getMethod<jboolean()>("isDone");
+    return method(this->self());
+  }
+
+  /// Calls callback with the value, or with the exception if the future
+  /// fails, without blocking any thread while waiting. The callback runs on
+  /// the thread that completes the future, or on this thread if it is already
+  /// done.
+  void whenComplete(Callback callback) const {
+    static const auto method =
+        Base::javaClassStatic()->template getMethod<javaobject(
+            alias_ref<JBiConsumer>)>("whenComplete");
+    auto consumer = JNativeBiConsumer::newObjectCxxArgs(
+        [callback = std::move(callback)](
+            alias_ref<jobject> value, alias_ref<jobject> error) {
+          callback(
+              static_ref_cast<T>(value), static_ref_cast<JThrowable>(error));
+        });
+    method(this->self(), consumer);
+  }
+
+#ifndef FBJNI_NO_EXCEPTION_PTR
+  /// Returns an std::future that receives convert(value) when this future
+  /// completes, or a JniException if it fails. convert runs on the completing
+  /// thread, and should copy whatever it needs out of the Java value, so that
+  /// the std::future may be read from threads that aren't attached.
+  template <
+      typename F,
+      typename R = decltype(std::declval<F&>()(std::declval<alias_ref<T>>()))>
+  std::future<R> toNative(F convert) const {
+    auto promise = std::make_shared<std::promise<R>>();
+    auto future = promise->get_future();
+    whenComplete([promise, convert](
+                     alias_ref<T> value, alias_ref<JThrowable> error) {
+      if (error) {
+        promise->set_exception(std::make_exception_ptr(JniException(error)));
+        return;
+      }
+      try {
+        setPromise(*promise, convert, value);
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+    return future;
+  }
+
+  /// Returns a new future for native code to complete. start is called with
+  /// a NativePromise, which it may store and complete later from any thread:
+  ///
+  /// return JCompletableFuture<JString>::fromNative(
+  ///     [&](NativePromise<JString> promise) {
+  ///       client.fetch(url, [promise](Response response) mutable {
+  ///         promise.setWith([&] { return make_jstring(response.body); });
+  ///       });
+  ///     });
+  template <typename F>
+  static local_ref<javaobject> fromNative(F&& start) {
+    auto future = create();
+    start(NativePromise<T>(future));
+    return future;
+  }
+
+ private:
+  template <typename R, typename F>
+  static void
+  setPromise(std::promise<R>& promise, F& convert, alias_ref<T> value) {
+    promise.set_value(convert(value));
+  }
+
+  template <typename F>
+  static void
+  setPromise(std::promise<void>& promise, F& convert, alias_ref<T> value) {
+    convert(value);
+    promise.set_value();
+  }
+#endif
+};
+
+#ifndef FBJNI_NO_EXCEPTION_PTR
+/**
+ * Completes a Java CompletableFuture from native code. Copies share the same
+ * future, and may be used on any thread. A thread that isn't attached to the
+ * VM is attached only while completing the future, with the app's class loader
+ * (see ThreadScope::WithClassLoader); one already inside a JNI call is used as
+ * is. Java continuations that aren't async run on the completing thread.
+ *
+ * If every copy is destroyed without completing the future, it fails with a
+ * CppException, so Java callers are never left waiting.
+ */
+template <typename T = jobject>
+class NativePromise {
+ public:
+  explicit NativePromise(alias_ref<typename JCompletableFuture<T>::javaobject>
+                             future)
+      : state_(std::make_shared<State>(make_global(future))) {}
+
+  /// Completes the future with makeValue(), or with the exception it throws.
+  template <typename F>
+  void setWith(F&& makeValue) {
+    auto future = state_->take();
+    if (!future) {
+      return;
+    }
+    ThreadScope::WithClassLoader([&] {
+      try {
+        auto value = makeValue();
+        future->complete(value);
+      } catch (...) {
+        future->completeExceptionally(
+            getJavaExceptionForCppException(std::current_exception()));
+      }
+      future.reset();
+    });
+  }
+
+  /// Fails the future with the Java translation of error.
+  void setException(std::exception_ptr error) {
+    state_->fail(error);
+  }
+
+ private:
+  struct State {
+    explicit State(
+        global_ref<typename JCompletableFuture<T>::javaobject> future)
+        : future_(std::move(future)) {}
+
+    // Failing the future can throw (attaching the thread, or completing it),
+    // which must not escape a destructor.
+    ~State() {
+      if (!future_) {
+        return;
+      }
+      try {
+        fail(std::make_exception_ptr(
+            std::runtime_error("NativePromise destroyed before completing")));
+      } catch (const std::exception& ex) {
+        FBJNI_LOGE("Failed to fail an abandoned NativePromise: %s", ex.what());
+      } catch (...) {
+        FBJNI_LOGE("Failed to fail an abandoned NativePromise");
+      }
+    }
+
+    // Only the first caller gets the future.
+    global_ref<typename JCompletableFuture<T>::javaobject> take() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return std::move(future_);
+    }
+
+    void fail(std::exception_ptr error) {
+      auto future = take();
+      if (!future) {
+        return;
+      }
+      ThreadScope::WithClassLoader([&] {
+        future->completeExceptionally(getJavaExceptionForCppException(error));
+        future.reset();
+      });
+    }
+
+    std::mutex mutex_;
+    global_ref<typename JCompletableFuture<T>::javaobject> future_;
+  };
+
+  std::shared_ptr<State> state_;
+};
+#endif
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Coroutine support for fbjni. This header is empty unless it is compiled as
+// C++20 with coroutines available, so it may be included unconditionally.
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine) && \
+    __has_include(<coroutine>)
+#define FBJNI_HAS_COROUTINES 1
+#endif
+
+#ifdef FBJNI_HAS_COROUTINES
+
+#include <fbjni/CompletableFuture.h>
+#include <fbjni/Executor.h>
+#include <fbjni/fbjni.h>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace facebook {
+namespace jni {
+
+/**
+ * Awaits a Java CompletableFuture without blocking a thread:
+ *
+ * global_ref<JString> body = co_await fetch(url);
+ *
+ * The value is returned as a global_ref, since the awaiting coroutine may
+ * resume on another thread. If the future fails, co_await throws a
+ * JniException. The coroutine resumes on the thread that completes the
+ * future, from inside a JNI call, so its JNIEnv is cached as usual; if the
+ * future is already done it doesn't suspend at all.
+ */
+template <typename T>
+class FutureAwaiter {
+ public:
+  explicit FutureAwaiter(
+      alias_ref<typename JCompletableFuture<T>::javaobject> future)
+      : future_(make_global(future)), state_(std::make_shared<State>()) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    // Once the coroutine may have resumed, this awaiter may already be gone,
+    // so only state is used after that.
+    auto state = state_;
+    state->handle = handle;
+    future_->whenComplete(
+        [state](alias_ref<T> value, alias_ref<JThrowable> error) {
+          if (error) {
+            state->error = make_global(error);
+          } else {
+            state->value = make_global(value);
+          }
+          if (state->step.exchange(kCompleted) == kSuspended) {
+            state->handle.resume();
+          }
+        });
+    // If the future was already done, continue without suspending.
+    return state->step.exchange(kSuspended) != kCompleted;
+  }
+
+  global_ref<T> await_resume() {
+    future_.reset();
+    if (state_->error) {
+      throw JniException(state_->error);
+    }
+    return std::move(state_->value);
+  }
+
+ private:
+  enum Step { kStarted, kSuspended, kCompleted };
+
+  struct State {
+    std::coroutine_handle<> handle;
+    std::atomic<Step> step{kStarted};
+    global_ref<T> value;
+    global_ref<JThrowable> error;
+  };
+
+  global_ref<typename JCompletableFuture<T>::javaobject> future_;
+  std::shared_ptr<State> state_;
+};
+
+namespace detail {
+
+template <typename R>
+struct FutureValueType {};
+
+template <typename T>
+struct FutureValueType<JCompletableFuture<T>> {
+  using type = T;
+};
+
+template <typename X>
+using FutureAwaiterFor =
+    FutureAwaiter<typename FutureValueType<ReprType<X>>::type>;
+
+} // namespace detail
+
+template <typename X>
+detail::FutureAwaiterFor<X> operator co_await(alias_ref<X> future) {
+  return detail::FutureAwaiterFor<X>(future);
+}
+
+template <typename X, typename Alloc>
+detail::FutureAwaiterFor<X> operator co_await(
+    const basic_strong_ref<X, Alloc>& future) {
+  return detail::FutureAwaiterFor<X>(future);
+}
+
+namespace detail {
+
+// Holds the result of a closure, or the exception it threw.
+template <typename R>
+class AwaitResult {
+ public:
+  template <typename F>
+  void run(F& f) {
+    try {
+      value_.emplace(f());
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+  }
+
+  R get() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return std::move(*value_);
+  }
+
+ private:
+  std::optional<R> value_;
+  std::exception_ptr error_;
+};
+
+template <>
+class AwaitResult<void> {
+ public:
+  template <typename F>
+  void run(F& f) {
+    try {
+      f();
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+  }
+
+  void get() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ private:
+  std::exception_ptr error_;
+};
+
+} // namespace detail
+
+/**
+ * Awaitable returned by runOn.
+ */
+template <typename F>
+class ExecutorAwaiter {
+ public:
+  using Result = std::invoke_result_t<F&>;
+
+  ExecutorAwaiter(alias_ref<JExecutor> executor, F&& closure)
+      : executor_(make_global(executor)), closure_(std::move(closure)) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // The task may resume the coroutine, and destroy this awaiter, before
+    // execute returns.
+    auto executor = make_local(executor_);
+    executor->execute([this, handle] {
+      result_.run(closure_);
+      handle.resume();
+    });
+  }
+
+  Result await_resume() {
+    return result_.get();
+  }
+
+ private:
+  global_ref<JExecutor> executor_;
+  F closure_;
+  detail::AwaitResult<Result> result_;
+};
+
+/**
+ * Runs closure on a thread of a Java Executor, and resumes the coroutine there
+ * with its result (or exception):
+ *
+ * std::string text = co_await runOn(ioExecutor, [&] { return readFile(); });
+ *
+ * The coroutine continues on the executor's thread, which is attached and
+ * inside a JNI call. Use resumeOn to just move the coroutine to the executor.
+ */
+template <typename F>
+ExecutorAwaiter<std::decay_t<F>> runOn(
+    alias_ref<JExecutor> executor,
+    F&& closure) {
+  return ExecutorAwaiter<std::decay_t<F>>(
+      executor, std::decay_t<F>(std::forward<F>(closure)));
+}
+
+inline auto resumeOn(alias_ref<JExecutor> executor) {
+  return runOn(executor, [] {});
+}
+
+template <typename T = void>
+class JniTask;
+
+namespace detail {
+
+template <typename T>
+using JniTaskJavaType = std::conditional_t<std::is_void<T>::value, jobject, T>;
+
+template <typename T>
+class JniTaskPromiseBase {
+ public:
+  using JavaType = JniTaskJavaType<T>;
+  using JavaFuture = typename JCompletableFuture<JavaType>::javaobject;
+
+  // The coroutine frame outlives the native call that started it, so the
+  // local reference to the future is handed to the JniTask straight away.
+  JniTaskPromiseBase()
+      : future_(JCompletableFuture<JavaType>::create()),
+        promise_(future_) {}
+
+  JniTask<T> get_return_object() {
+    return JniTask<T>(std::move(future_));
+  }
+
+  std::suspend_never initial_suspend() noexcept {
+    return {};
+  }
+
+  std::suspend_never final_suspend() noexcept {
+    return {};
+  }
+
+  void unhandled_exception() {
+    promise_.setException(std::current_exception());
+  }
+
+ protected:
+  local_ref<JavaFuture> future_;
+  NativePromise<JavaType> promise_;
+};
+
+template <typename T>
+class JniTaskPromise : public JniTaskPromiseBase<T> {
+ public:
+  template <typename U>
+  void return_value(U&& value) {
+    this->promise_.setWith([&] { return alias_ref<T>(value); });
+  }
+};
+
+template <>
+class JniTaskPromise<void> : public JniTaskPromiseBase<void> {
+ public:
+  void return_void() {
+    promise_.setWith([] { return alias_ref<jobject>(nullptr); });
+  }
+};
+
+} // namespace detail
+
+/**
+ * A coroutine that is a CompletableFuture in Java. Registered natives can
+ * return one, and Java receives the future:
+ *
+ * static JniTask<JString> fetch(alias_ref<jclass>, std::string url) {
+ *   global_ref<JString> body = co_await startFetch(url);
+ *   std::string summary = co_await runOn(cpuExecutor, [&] {
+ *     return summarize(body);
+ *   });
+ *   co_return make_jstring(summary);
+ * }
+ *
+ * private static native CompletableFuture<String> fetch(String url);
+ *
+ * T is the Java type of the result (for example JString, or jobject), or void
+ * for CompletableFuture<Void>. The coroutine starts running immediately, and
+ * the future completes when it returns, or fails with the translation of an
+ * exception it throws. A coroutine may resume on other threads, where
+ * alias_refs and local_refs from before a co_await are no longer valid: take
+ * arguments as C++ values or global_refs instead.
+ */
+template <typename T>
+class JniTask {
+ public:
+  using promise_type = detail::JniTaskPromise<T>;
+  using JavaFuture = typename detail::JniTaskPromiseBase<T>::JavaFuture;
+
+  explicit JniTask(local_ref<JavaFuture> future)
+      : future_(std::move(future)) {}
+
+  /// The Java future that the coroutine completes.
+  local_ref<JavaFuture> getFuture() && {
+    return std::move(future_);
+  }
+
+ private:
+  local_ref<JavaFuture> future_;
+};
+
+namespace detail {
+
+// convert return from JniTask<T>
+template <typename T>
+struct Convert<JniTask<T>> {
+  typedef typename JniTask<T>::JavaFuture jniType;
+  static jniType toJniRet(JniTask<T> task) {
+    return std::move(task).getFuture().release();
+  }
+};
+
+} // namespace detail
+
+} // namespace jni
+} // namespace facebook
+
+#endif // FBJNI_HAS_COROUTINES
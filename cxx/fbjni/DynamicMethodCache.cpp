@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fbjni/DynamicMethodCache.h>
+
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace facebook {
+namespace jni {
+
+namespace {
+
+// A method name can't contain '(', which starts every descriptor, so the two
+// concatenated are unambiguous.
+std::string makeSignature(const char* name, const char* descriptor) {
+  std::string signature = name;
+  signature += descriptor;
+  return signature;
+}
+
+char returnTypeOf(const char* descriptor) {
+  const char* end = std::strchr(descriptor, ')');
+  if (!end || !end[1]) {
+    throw std::invalid_argument(
+        std::string("Malformed method descriptor: ") + descriptor);
+  }
+  return end[1] == '[' ? 'L' : end[1];
+}
+
+} // namespace
+
+DynamicMethod::DynamicMethod(
+    global_ref<JClass> cls,
+    jmethodID id,
+    bool isStatic,
+    char returnType)
+    : cls_(std::move(cls)),
+      id_(id),
+      isStatic_(isStatic),
+      returnType_(returnType) {}
+
+jvalue DynamicMethod::invoke(alias_ref<jobject> self, const jvalue* args)
+    const {
+  const auto env = Environment::current();
+  jvalue result;
+  result.j = 0;
+#define FBJNI_DYNAMIC_INVOKE(DESCRIPTOR, NAME, MEMBER)                     \
+  case DESCRIPTOR:                                                         \
+    result.MEMBER = isStatic_                                              \
+        ? env->CallStatic##NAME##MethodA(cls_.get(), id_, args)            \
+        : env->Call##NAME##MethodA(self.get(), id_, args);                 \
+    break;
+  switch (returnType_) {
+    FBJNI_DYNAMIC_INVOKE('Z', Boolean, z)
+    FBJNI_DYNAMIC_INVOKE('B', Byte, b)
+    FBJNI_DYNAMIC_INVOKE('C', Char, c)
+    FBJNI_DYNAMIC_INVOKE('S', Short, s)
+    FBJNI_DYNAMIC_INVOKE('I', Int, i)
+    FBJNI_DYNAMIC_INVOKE('J', Long, j)
+    FBJNI_DYNAMIC_INVOKE('F', Float, f)
+    FBJNI_DYNAMIC_INVOKE('D', Double, d)
+    FBJNI_DYNAMIC_INVOKE('L', Object, l)
+    case 'V':
+      if (isStatic_) {
+        env->CallStaticVoidMethodA(cls_.get(), id_, args);
+      } else {
+        env->CallVoidMethodA(self.get(), id_, args);
+      }
+      break;
+  }
+#undef FBJNI_DYNAMIC_INVOKE
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
+  return result;
+}
+
+DynamicMethodCache::CallSite::CallSite(
+    DynamicMethodCache& cache,
+    std::string name,
+    std::string descriptor,
+    bool isStatic)
+    : cache_(cache),
+      name_(std::move(name)),
+      descriptor_(std::move(descriptor)),
+      isStatic_(isStatic) {}
+
+const DynamicMethod& DynamicMethodCache::CallSite::lookup(
+    alias_ref<JClass> cls) {
+  auto last = last_.load(std::memory_order_acquire);
+  if (last && Environment::current()->IsSameObject(
+                  last->cls_.get(), cls.get()) != JNI_FALSE) {
+    cache_.hits_.fetch_add(1, std::memory_order_relaxed);
+    cache_.callSiteHits_.fetch_add(1, std::memory_order_relaxed);
+    return *last;
+  }
+  auto& method =
+      cache_.lookup(cls, name_.c_str(), descriptor_.c_str(), isStatic_);
+  last_.store(&method, std::memory_order_release);
+  return method;
+}
+
+const DynamicMethod& DynamicMethodCache::getMethod(
+    alias_ref<JClass> cls,
+    const char* name,
+    const char* descriptor) {
+  return lookup(cls, name, descriptor, false);
+}
+
+const DynamicMethod& DynamicMethodCache::getStaticMethod(
+    alias_ref<JClass> cls,
+    const char* name,
+    const char* descriptor) {
+  return lookup(cls, name, descriptor, true);
+}
+
+DynamicMethodCache::Stats DynamicMethodCache::stats() const {
+  return Stats{
+      hits_.load(std::memory_order_relaxed),
+      misses_.load(std::memory_order_relaxed),
+      callSiteHits_.load(std::memory_order_relaxed),
+      std::chrono::nanoseconds(resolveNanos_.load(std::memory_order_relaxed)),
+  };
+}
+
+void DynamicMethodCache::resetStats() {
+  hits_.store(0, std::memory_order_relaxed);
+  misses_.store(0, std::memory_order_relaxed);
+  callSiteHits_.store(0, std::memory_order_relaxed);
+  resolveNanos_.store(0, std::memory_order_relaxed);
+}
+
+const DynamicMethod* DynamicMethodCache::find(
+    alias_ref<JClass> cls,
+    const std::string& signature,
+    bool isStatic) const {
+  auto it = methods_.find(signature);
+  if (it == methods_.end()) {
+    return nullptr;
+  }
+  const auto env = Environment::current();
+  for (const auto& method : it->second) {
+    if (method->isStatic_ == isStatic &&
+        env->IsSameObject(method->cls_.get(), cls.get()) != JNI_FALSE) {
+      return method.get();
+    }
+  }
+  return nullptr;
+}
+
+const DynamicMethod& DynamicMethodCache::lookup(
+    alias_ref<JClass> cls,
+    const char* name,
+    const char* descriptor,
+    bool isStatic) {
+  auto signature = makeSignature(name, descriptor);
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    if (auto method = find(cls, signature, isStatic)) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return *method;
+    }
+  }
+
+  // Resolve without the lock held, so that hits on other threads don't wait
+  // on the VM.
+  auto start = std::chrono::steady_clock::now();
+  const auto env = Environment::current();
+  auto id = isStatic ? env->GetStaticMethodID(cls.get(), name, descriptor)
+                     : env->GetMethodID(cls.get(), name, descriptor);
+  FACEBOOK_JNI_THROW_EXCEPTION_IF(!id);
+  std::unique_ptr<DynamicMethod> resolved(new DynamicMethod(
+      make_global(cls), id, isStatic, returnTypeOf(descriptor)));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  resolveNanos_.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+      std::memory_order_relaxed);
+
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  // Another thread may have resolved the same method in the meantime.
+  if (auto method = find(cls, signature, isStatic)) {
+    return *method;
+  }
+  auto& methods = methods_[signature];
+  methods.push_back(std::move(resolved));
+  return *methods.back();
+}
+
+} // namespace jni
+} // namespace facebook
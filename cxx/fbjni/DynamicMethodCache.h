@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook {
+namespace jni {
+
+/**
+ * A Java method looked up at runtime, for calling with arguments whose types
+ * are only known at runtime. Arguments are passed as jvalues in the order the
+ * descriptor gives them, and the result comes back in the jvalue member that
+ * matches returnType(). An object result is a new local reference, which the
+ * caller owns.
+ */
+class DynamicMethod {
+ public:
+  jmethodID getId() const {
+    return id_;
+  }
+
+  bool isStatic() const {
+    return isStatic_;
+  }
+
+  /// The first character of the return type's descriptor: 'V' for void, the
+  /// letter of a primitive type, or 'L' for any reference type, arrays
+  /// included.
+  char returnType() const {
+    return returnType_;
+  }
+
+  alias_ref<JClass> getClass() const {
+    return cls_;
+  }
+
+  /// Calls the method, on self unless the method is static. A Java exception
+  /// is rethrown as a JniException.
+  jvalue invoke(alias_ref<jobject> self, const jvalue* args) const;
+
+ private:
+  friend class DynamicMethodCache;
+
+  DynamicMethod(
+      global_ref<JClass> cls,
+      jmethodID id,
+      bool isStatic,
+      char returnType);
+
+  global_ref<JClass> cls_;
+  jmethodID id_;
+  bool isStatic_;
+  char returnType_;
+};
+
+/**
+ * Caches methods by class, name and descriptor, for callers such as scripting
+ * bridges that only know which method to call at runtime. A hit costs an
+ * IsSameObject call for each class cached under the same name and descriptor,
+ * where looking the method up again would be a GetMethodID, which takes locks
+ * in the VM. A call site that keeps seeing the same class can skip the map as
+ * well with a CallSite.
+ *
+ * Methods are only dropped when the cache is destroyed, and their classes
+ * can't be unloaded until then. Safe to use from any number of threads.
+ */
+class DynamicMethodCache {
+ public:
+  struct Stats {
+    /// Lookups that found the method in the map or in a CallSite.
+    uint64_t hits;
+    /// Lookups that had to resolve the method.
+    uint64_t misses;
+    /// The hits that came from a CallSite.
+    uint64_t callSiteHits;
+    /// Time spent resolving methods, over all the misses.
+    std::chrono::nanoseconds resolveTime;
+  };
+
+  /**
+   * A monomorphic inline cache for one call site. It remembers the method it
+   * returned last, and returns it again without going to the map if asked
+   * about the same class. The cache must outlive it.
+   */
+  class CallSite {
+   public:
+    CallSite(
+        DynamicMethodCache& cache,
+        std::string name,
+        std::string descriptor,
+        bool isStatic = false);
+
+    CallSite(const CallSite&) = delete;
+    CallSite& operator=(const CallSite&) = delete;
+
+    const DynamicMethod& lookup(alias_ref<JClass> cls);
+
+   private:
+    DynamicMethodCache& cache_;
+    const std::string name_;
+    const std::string descriptor_;
+    const bool isStatic_;
+    std::atomic<const DynamicMethod*> last_{nullptr};
+  };
+
+  DynamicMethodCache() = default;
+
+  DynamicMethodCache(const DynamicMethodCache&) = delete;
+  DynamicMethodCache& operator=(const DynamicMethodCache&) = delete;
+
+  /// The returned methods stay valid as long as the cache. Throws a
+  /// JniException (NoSuchMethodError) if cls has no such method.
+  const DynamicMethod&
+  getMethod(alias_ref<JClass> cls, const char* name, const char* descriptor);
+  const DynamicMethod& getStaticMethod(
+      alias_ref<JClass> cls,
+      const char* name,
+      const char* descriptor);
+
+  Stats stats() const;
+  void resetStats();
+
+ private:
+  const DynamicMethod* find(
+      alias_ref<JClass> cls,
+      const std::string& signature,
+      bool isStatic) const;
+  const DynamicMethod& lookup(
+      alias_ref<JClass> cls,
+      const char* name,
+      const char* descriptor,
+      bool isStatic);
+
+  mutable std::shared_timed_mutex mutex_;
+  // Keyed by signature. Each entry holds that method for every class it has
+  // been looked up on.
+  std::unordered_map<std::string, std::vector<std::unique_ptr<DynamicMethod>>>
+      methods_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> callSiteHits_{0};
+  std::atomic<int64_t> resolveNanos_{0};
+};
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fbjni/EventRing.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace facebook {
+namespace jni {
+
+namespace {
+
+size_t roundUpToPowerOfTwo(size_t value) {
+  if (value > EventRing::kMaxCapacity) {
+    throw std::invalid_argument("EventRing capacity is too large");
+  }
+  size_t result = 64;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+size_t alignUp(size_t value) {
+  return (value + EventRing::kAlignment - 1) & ~(EventRing::kAlignment - 1);
+}
+
+} // namespace
+
+constexpr size_t EventRing::kHeaderSize;
+constexpr size_t EventRing::kAlignment;
+constexpr int32_t EventRing::kPadding;
+constexpr size_t EventRing::kMaxCapacity;
+
+EventRing::EventRing(size_t capacity)
+    : capacity_(roundUpToPowerOfTwo(capacity)),
+      data_(new uint8_t[capacity_]) {}
+
+bool EventRing::tryWrite(const void* data, size_t size) {
+  size_t recordSize = alignUp(kHeaderSize + size);
+  if (recordSize > capacity_ / 2 || closed_.load(std::memory_order_relaxed)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Claim space, including padding to the end of the ring if the record
+  // doesn't fit before it.
+  uint64_t start = reserved_.load(std::memory_order_relaxed);
+  uint64_t end;
+  do {
+    size_t contiguous = capacity_ - (start & (capacity_ - 1));
+    end = start + (recordSize <= contiguous ? recordSize
+                                            : contiguous + recordSize);
+    if (end - head_.load(std::memory_order_acquire) > capacity_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!reserved_.compare_exchange_weak(
+      start, end, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+  size_t offset = start & (capacity_ - 1);
+  if (end - start != recordSize) {
+    std::memcpy(data_.get() + offset, &kPadding, kHeaderSize);
+    offset = 0;
+  }
+  int32_t length = static_cast<int32_t>(size);
+  std::memcpy(data_.get() + offset, &length, kHeaderSize);
+  std::memcpy(data_.get() + offset + kHeaderSize, data, size);
+
+  // Publish in the order space was claimed, so that the consumer never sees a
+  // record that is still being copied in.
+  while (committed_.load(std::memory_order_acquire) != start) {
+    std::this_thread::yield();
+  }
+  committed_.store(end);
+  // Only the first producer to see the consumer waiting signals it.
+  if (waiting_.load() && waiting_.exchange(false)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wakeup_.notify_one();
+  }
+  return true;
+}
+
+void EventRing::close() {
+  closed_.store(true);
+  std::lock_guard<std::mutex> lock(mutex_);
+  wakeup_.notify_all();
+}
+
+int64_t EventRing::awaitBatch(
+    size_t consumed,
+    std::chrono::milliseconds timeout) {
+  uint64_t head = head_.load(std::memory_order_relaxed) + consumed;
+  head_.store(head, std::memory_order_release);
+
+  uint64_t committed = committed_.load(std::memory_order_acquire);
+  if (committed == head && !closed_.load() && timeout.count() > 0) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Producers check waiting_ after publishing a record, so either one of
+    // them sees it and signals, or the predicate sees their record.
+    waiting_.store(true);
+    wakeup_.wait_for(lock, timeout, [&] {
+      committed = committed_.load();
+      return committed != head || closed_.load();
+    });
+    waiting_.store(false, std::memory_order_relaxed);
+  }
+
+  if (committed == head && closed_.load()) {
+    // Records committed after close was called are still delivered.
+    committed = committed_.load();
+    if (committed == head) {
+      return -1;
+    }
+  }
+  return static_cast<int64_t>(committed - head);
+}
+
+local_ref<JEventRing::javaobject> JEventRing::create(
+    std::shared_ptr<EventRing> ring) {
+  return newObjectCxxArgs(std::move(ring));
+}
+
+void JEventRing::OnLoad() {
+  registerHybrid({
+      makeNativeMethod("nativeGetBuffer", JEventRing::getBuffer),
+      makeNativeMethod("nativeAwaitBatch", JEventRing::awaitBatch),
+      makeNativeMethod("nativeClose", JEventRing::close),
+  });
+}
+
+local_ref<JByteBuffer> JEventRing::getBuffer() {
+  return JByteBuffer::wrapBytes(ring_->data(), ring_->capacity());
+}
+
+jint JEventRing::awaitBatch(jint consumed, jlong timeoutMs) {
+  return static_cast<jint>(ring_->awaitBatch(
+      static_cast<size_t>(consumed), std::chrono::milliseconds(timeoutMs)));
+}
+
+void JEventRing::close() {
+  ring_->close();
+}
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/ByteBuffer.h>
+#include <fbjni/fbjni.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace facebook {
+namespace jni {
+
+/**
+ * A ring buffer for sending events from native threads to Java without a JNI
+ * call, or even an attached thread, per event. Any number of native threads
+ * write length-prefixed records with tryWrite; one Java thread drains them in
+ * batches through com.facebook.jni.EventRing, reading the records straight out
+ * of a direct ByteBuffer over the ring's memory:
+ *
+ * auto ring = std::make_shared<EventRing>(1 << 20);
+ * std::thread([ring] {
+ *   while (...) {
+ *     Metric metric = ...;
+ *     ring->tryWrite(&metric, sizeof(metric));
+ *   }
+ * }).detach();
+ * return JEventRing::create(ring);
+ *
+ * Producers claim space with a compare-and-swap on the write index and never
+ * wait for the consumer: tryWrite returns false, and counts the event as
+ * dropped, if the ring is full. Records become visible to the consumer in the
+ * order their space was claimed, so a producer does wait (spinning) for the
+ * producers that claimed space before it to finish copying; one preempted in
+ * between holds up the rest. Each time the consumer waits, only the first
+ * producer to see it waiting signals it.
+ *
+ * Each record is a native-endian int32 length followed by the payload, padded
+ * to a multiple of kAlignment. A record never wraps around the end of the
+ * ring; a length of kPadding marks the unused space skipped instead.
+ */
+class EventRing {
+ public:
+  static constexpr size_t kHeaderSize = sizeof(int32_t);
+  static constexpr size_t kAlignment = sizeof(int32_t);
+  static constexpr int32_t kPadding = -1;
+  static constexpr size_t kMaxCapacity = size_t{1} << 30;
+
+  /// capacity is rounded up to a power of two, and must be at most
+  /// kMaxCapacity.
+  explicit EventRing(size_t capacity);
+
+  EventRing(const EventRing&) = delete;
+  EventRing& operator=(const EventRing&) = delete;
+
+  /// Copies a record into the ring. Returns false if the ring is full or
+  /// closed, or if the record is larger than half the ring. Safe to call from
+  /// any number of threads at once.
+  bool tryWrite(const void* data, size_t size);
+
+  /// Makes tryWrite fail from now on, and wakes the consumer so that it can
+  /// finish draining the ring.
+  void close();
+
+  bool isClosed() const {
+    return closed_.load();
+  }
+
+  /// The number of records rejected by tryWrite so far.
+  uint64_t droppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  uint8_t* data() const {
+    return data_.get();
+  }
+
+  /// Consumer side. Frees the consumed bytes read since the last call, then
+  /// waits up to timeout for records. Returns the number of bytes of complete
+  /// records starting at the read position, 0 if none were written before the
+  /// timeout, or -1 if the ring is closed and has been drained. Only one
+  /// thread may consume at a time.
+  int64_t awaitBatch(size_t consumed, std::chrono::milliseconds timeout);
+
+ private:
+  const size_t capacity_;
+  const std::unique_ptr<uint8_t[]> data_;
+
+  // Positions in the ring, in bytes since it was created. Records in
+  // [head_, committed_) are ready for the consumer, and records in
+  // [committed_, reserved_) are still being copied in.
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> committed_{0};
+  std::atomic<uint64_t> reserved_{0};
+
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<bool> closed_{false};
+  std::atomic<bool> waiting_{false};
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+};
+
+/**
+ * com.facebook.jni.EventRing: the Java consumer of an EventRing. The Java
+ * object shares ownership of the ring, so producers may keep writing to their
+ * own shared_ptr after it is collected.
+ */
+class JEventRing : public HybridClass<JEventRing> {
+ public:
+  static constexpr auto kJavaDescriptor = "Lcom/facebook/jni/EventRing;";
+
+  static local_ref<javaobject> create(std::shared_ptr<EventRing> ring);
+
+  explicit JEventRing(std::shared_ptr<EventRing> ring)
+      : ring_(std::move(ring)) {}
+
+  static void OnLoad();
+
+  const std::shared_ptr<EventRing>& ring() const {
+    return ring_;
+  }
+
+ private:
+  local_ref<JByteBuffer> getBuffer();
+  jint awaitBatch(jint consumed, jlong timeoutMs);
+  void close();
+
+  std::shared_ptr<EventRing> ring_;
+};
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fbjni/Executor.h>
+
+#include <mutex>
+
+namespace facebook {
+namespace jni {
+
+namespace {
+
+// Batches that have finished running, ready for reuse. Holding a few is
+// enough to avoid allocating a new one for each batch in a steady stream.
+constexpr size_t kMaxIdleBatches = 8;
+
+// Never destroyed, so exit doesn't have to delete references without a JVM.
+std::mutex idleBatchesMutex;
+auto& idleBatches =
+    *new std::vector<global_ref<JNativeTaskBatch::jhybridobject>>();
+
+local_ref<JNativeTaskBatch::jhybridobject> obtainBatch() {
+  {
+    std::lock_guard<std::mutex> lock(idleBatchesMutex);
+    if (!idleBatches.empty()) {
+      auto batch = make_local(idleBatches.back());
+      idleBatches.pop_back();
+      return batch;
+    }
+  }
+  return JNativeTaskBatch::newObjectCxxArgs();
+}
+
+void recycleBatch(alias_ref<JNativeTaskBatch::jhybridobject> batch) {
+  auto ref = make_global(batch);
+  std::lock_guard<std::mutex> lock(idleBatchesMutex);
+  if (idleBatches.size() < kMaxIdleBatches) {
+    idleBatches.push_back(std::move(ref));
+  }
+}
+
+} // namespace
+
+void JNativeTaskBatch::OnLoad() {
+  registerHybrid({
+      makeNativeMethod("nativeRun", JNativeTaskBatch::run),
+      makeNativeMethod("nativeDiscard", JNativeTaskBatch::discard),
+  });
+}
+
+void JNativeTaskBatch::submit(
+    alias_ref<JExecutor> executor,
+    std::vector<std::function<void()>>&& tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+  static const auto method =
+      javaClassStatic()->getMethod<void(alias_ref<JExecutor>, jint)>("submit");
+  auto batch = obtainBatch();
+  auto count = static_cast<jint>(tasks.size());
+  batch->cthis()->tasks_ = std::move(tasks);
+  batch->cthis()->remaining_.store(count);
+  method(batch, executor, count);
+}
+
+void JNativeTaskBatch::run(alias_ref<jhybridobject> self, jint index) {
+  auto batch = self->cthis();
+  // Release the task's captures as soon as it has run.
+  auto task = std::move(batch->tasks_[index]);
+  batch->tasks_[index] = nullptr;
+  struct Finish {
+    alias_ref<jhybridobject> self;
+    ~Finish() {
+      finished(self, 1);
+    }
+  } finish{self};
+  task();
+}
+
+void JNativeTaskBatch::discard(alias_ref<jhybridobject> self, jint first) {
+  auto batch = self->cthis();
+  // Tasks before first were submitted and may be running, so only the
+  // rejected ones can be touched here.
+  auto count = batch->tasks_.size() - static_cast<size_t>(first);
+  for (auto i = static_cast<size_t>(first); i < batch->tasks_.size(); ++i) {
+    batch->tasks_[i] = nullptr;
+  }
+  finished(self, count);
+}
+
+void JNativeTaskBatch::finished(alias_ref<jhybridobject> self, size_t count) {
+  auto batch = self->cthis();
+  if (batch->remaining_.fetch_sub(count) == count) {
+    batch->tasks_.clear();
+    recycleBatch(self);
+  }
+}
+
+} // namespace jni
+} // namespace facebook
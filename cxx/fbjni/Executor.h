@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/NativeRunnable.h>
+#include <fbjni/fbjni.h>
+
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace facebook {
+namespace jni {
+
+struct JExecutor;
+
+/**
+ * com.facebook.jni.NativeTaskBatch: the Java handle for a batch of C++ tasks
+ * submitted with JExecutor::submitBatch. Java wraps each task in a small
+ * Runnable that calls back into the batch by index. Once every task has run,
+ * the handle goes back to a small pool to be reused by a later batch.
+ */
+class JNativeTaskBatch : public HybridClass<JNativeTaskBatch> {
+ public:
+  static constexpr auto kJavaDescriptor = "Lcom/facebook/jni/NativeTaskBatch;";
+
+  JNativeTaskBatch() = default;
+
+  static void OnLoad();
+
+  static void submit(
+      alias_ref<JExecutor> executor,
+      std::vector<std::function<void()>>&& tasks);
+
+ private:
+  static void run(alias_ref<jhybridobject> self, jint index);
+  static void discard(alias_ref<jhybridobject> self, jint first);
+
+  // Recycles the batch once the last of its tasks has run or been discarded.
+  static void finished(alias_ref<jhybridobject> self, size_t count);
+
+  std::vector<std::function<void()>> tasks_;
+  std::atomic<size_t> remaining_{0};
+};
+
+struct JExecutor : public JavaClass<JExecutor> {
+  static auto constexpr kJavaDescriptor = "Ljava/util/concurrent/Executor;";
+
+  void execute(alias_ref<JRunnable> runnable) const {
+    static const auto method =
+        javaClassStatic()->getMethod<void(alias_ref<JRunnable>)>("execute");
+    method(self(), runnable);
+  }
+
+  /// Runs task on the executor, wrapped in a JNativeRunnable.
+  void execute(std::function<void()> task) const {
+    execute(JNativeRunnable::newObjectCxxArgs(std::move(task)));
+  }
+
+  /// Runs each task on the executor. Unlike calling execute for each task,
+  /// this takes one JNI call and (usually) no new hybrid object for the whole
+  /// batch; each task still costs a small Java Runnable and a call back into
+  /// C++ when it runs. If the executor rejects a task, the exception is
+  /// rethrown and the rest of the batch is destroyed without being run.
+  void submitBatch(std::vector<std::function<void()>> tasks) const {
+    JNativeTaskBatch::submit(self(), std::move(tasks));
+  }
+};
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/ColumnarBatch.h>
+#include <fbjni/fbjni.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook {
+namespace jni {
+
+/**
+ * Binds a C++ struct to a Java class field by field, so that natives can take
+ * and return the struct (or an std::vector of them, as a Java array) directly.
+ * Specialize JavaStruct for the struct, naming the Java class and listing its
+ * fields:
+ *
+ * struct Point {
+ *   int32_t x;
+ *   int32_t y;
+ *   std::string label;
+ * };
+ *
+ * struct JPoint : JavaClass<JPoint> {
+ *   static constexpr auto kJavaDescriptor = "Lcom/example/Point;";
+ * };
+ *
+ * namespace facebook {
+ * namespace jni {
+ * template <>
+ * struct JavaStruct<Point> {
+ *   using JavaType = JPoint;
+ *   static constexpr auto fields() {
+ *     return makeJavaFields(
+ *         javaField("x", &Point::x),
+ *         javaField("y", &Point::y),
+ *         javaField("label", &Point::label));
+ *   }
+ * };
+ * } // namespace jni
+ * } // namespace facebook
+ *
+ * and then:
+ *
+ * Point nativeMidpoint(alias_ref<jclass>, Point a, std::vector<Point> rest);
+ *
+ * Fields may be bool, integers, enums and floating point (stored as the Java
+ * primitive of the same size, as for ColumnarBatch), std::string, or another
+ * struct with its own JavaStruct binding. Field IDs are looked up once per
+ * struct. The C++ struct must be default constructible, and the Java class
+ * must have a no-argument constructor if structs are returned to Java. Null
+ * Strings and nested objects read as empty values.
+ *
+ * Each struct still costs one JNI call per field; for large numbers of records
+ * of only primitive and string fields, Columns is much cheaper.
+ */
+template <typename T>
+struct JavaStruct {};
+
+template <typename Record, typename... Fields>
+struct JavaFields {
+  constexpr explicit JavaFields(Column<Record, Fields>... columns)
+      : fields(columns...) {}
+
+  std::tuple<Column<Record, Fields>...> fields;
+};
+
+template <typename Record, typename Field>
+constexpr Column<Record, Field> javaField(
+    const char* name,
+    Field Record::*member) {
+  return Column<Record, Field>{name, member};
+}
+
+template <typename Record, typename... Fields>
+constexpr JavaFields<Record, Fields...> makeJavaFields(
+    Column<Record, Fields>... fields) {
+  return JavaFields<Record, Fields...>(fields...);
+}
+
+namespace detail {
+
+template <typename T, typename Enable = void>
+struct IsJavaStruct : std::false_type {};
+
+template <typename T>
+struct IsJavaStruct<
+    T,
+    typename std::enable_if<
+        !std::is_void<typename JavaStruct<T>::JavaType>::value>::type>
+    : std::true_type {};
+
+template <typename T, typename Fields = decltype(JavaStruct<T>::fields())>
+class StructBinding;
+
+// Reads and writes one field. Temporary references are held with Alloc, so
+// that structs converted inside a JniLocalScope can leave them to the frame.
+template <typename Field, typename Enable = void>
+struct StructField {
+  using JniType = typename ColumnType<Field>::type;
+
+  template <typename Alloc>
+  static Field read(alias_ref<jobject> obj, JField<JniType> id) {
+    return fromColumnValue<Field>(obj->getFieldValue(id));
+  }
+
+  template <typename Alloc>
+  static void
+  write(alias_ref<jobject> obj, JField<JniType> id, const Field& value) {
+    obj->setFieldValue(id, static_cast<JniType>(value));
+  }
+};
+
+template <>
+struct StructField<std::string> {
+  using JniType = jstring;
+
+  template <typename Alloc>
+  static std::string read(alias_ref<jobject> obj, JField<jstring> id) {
+    basic_strong_ref<jstring, Alloc> str = obj->getFieldValue(id);
+    return str ? str->toStdString() : std::string();
+  }
+
+  template <typename Alloc>
+  static void write(
+      alias_ref<jobject> obj,
+      JField<jstring> id,
+      const std::string& value) {
+    basic_strong_ref<JString, Alloc> str = make_jstring(value);
+    obj->setFieldValue(id, str.get());
+  }
+};
+
+template <typename Field>
+struct StructField<
+    Field,
+    typename std::enable_if<IsJavaStruct<Field>::value>::type> {
+  using JniType = typename JavaStruct<Field>::JavaType::javaobject;
+
+  template <typename Alloc>
+  static Field read(alias_ref<jobject> obj, JField<JniType> id) {
+    basic_strong_ref<JniType, Alloc> nested = obj->getFieldValue(id);
+    return StructBinding<Field>::template fromJava<Alloc>(nested);
+  }
+
+  template <typename Alloc>
+  static void
+  write(alias_ref<jobject> obj, JField<JniType> id, const Field& value) {
+    auto nested = StructBinding<Field>::template toJava<Alloc>(value);
+    obj->setFieldValue(id, nested.get());
+  }
+};
+
+template <typename T, typename... Fields>
+class StructBinding<T, JavaFields<T, Fields...>> {
+ public:
+  using JavaType = typename JavaStruct<T>::JavaType;
+  using javaobject = typename JavaType::javaobject;
+
+  // Local references a single struct needs: the object itself, and a
+  // temporary for each String or nested field.
+  static constexpr size_t kRefs = sizeof...(Fields) + 1;
+
+  template <typename Alloc = LocalReferenceAllocator>
+  static T fromJava(alias_ref<javaobject> obj) {
+    T result{};
+    if (obj) {
+      read<Alloc>(obj, result, std::index_sequence_for<Fields...>());
+    }
+    return result;
+  }
+
+  template <typename Alloc = LocalReferenceAllocator>
+  static basic_strong_ref<javaobject, Alloc> toJava(const T& value) {
+    basic_strong_ref<javaobject, Alloc> obj =
+        detail::newInstance<JavaType>();
+    write<Alloc>(obj, value, std::index_sequence_for<Fields...>());
+    return obj;
+  }
+
+ private:
+  using Ids = std::tuple<JField<typename StructField<Fields>::JniType>...>;
+
+  static const Ids& ids() {
+    static const Ids ids = resolve(std::index_sequence_for<Fields...>());
+    return ids;
+  }
+
+  template <size_t... Is>
+  static Ids resolve(std::index_sequence<Is...>) {
+    constexpr auto fields = JavaStruct<T>::fields();
+    auto cls = JavaType::javaClassStatic();
+    return Ids(cls->template getField<typename StructField<Fields>::JniType>(
+        std::get<Is>(fields.fields).name)...);
+  }
+
+  template <typename Alloc, size_t... Is>
+  static void
+  read(alias_ref<jobject> obj, T& result, std::index_sequence<Is...>) {
+    constexpr auto fields = JavaStruct<T>::fields();
+    const auto& fieldIds = ids();
+    (void)std::initializer_list<int>{
+        (result.*std::get<Is>(fields.fields).member =
+             StructField<Fields>::template read<Alloc>(
+                 obj, std::get<Is>(fieldIds)),
+         0)...};
+  }
+
+  template <typename Alloc, size_t... Is>
+  static void
+  write(alias_ref<jobject> obj, const T& value, std::index_sequence<Is...>) {
+    constexpr auto fields = JavaStruct<T>::fields();
+    const auto& fieldIds = ids();
+    (void)std::initializer_list<int>{
+        (StructField<Fields>::template write<Alloc>(
+             obj,
+             std::get<Is>(fieldIds),
+             value.*std::get<Is>(fields.fields).member),
+         0)...};
+  }
+};
+
+template <typename T>
+using StructArray =
+    JArrayClass<typename JavaStruct<T>::JavaType::javaobject>;
+
+// Arrays of structs are converted a few elements per local frame. The
+// temporaries for each element are left for PopLocalFrame to reclaim instead
+// of being deleted one at a time.
+constexpr size_t kStructsPerLocalFrame = 32;
+
+template <typename T>
+std::vector<T> structsFromJava(
+    alias_ref<typename StructArray<T>::javaobject> array) {
+  std::vector<T> result;
+  if (!array) {
+    return result;
+  }
+  size_t count = array->size();
+  result.reserve(count);
+  for (size_t start = 0; start < count; start += kStructsPerLocalFrame) {
+    size_t end = std::min(count, start + kStructsPerLocalFrame);
+    JniLocalScope scope(
+        static_cast<jint>(kStructsPerLocalFrame * StructBinding<T>::kRefs));
+    for (size_t i = start; i < end; ++i) {
+      frame_local_ref<typename JavaStruct<T>::JavaType::javaobject> element =
+          array->getElement(i);
+      result.push_back(
+          StructBinding<T>::template fromJava<FrameLocalReferenceAllocator>(
+              element));
+    }
+  }
+  return result;
+}
+
+template <typename T>
+local_ref<typename StructArray<T>::javaobject> structsToJava(
+    const std::vector<T>& values) {
+  auto array = StructArray<T>::newArray(values.size());
+  for (size_t start = 0; start < values.size();
+       start += kStructsPerLocalFrame) {
+    size_t end = std::min(values.size(), start + kStructsPerLocalFrame);
+    JniLocalScope scope(
+        static_cast<jint>(kStructsPerLocalFrame * StructBinding<T>::kRefs));
+    for (size_t i = start; i < end; ++i) {
+      auto element =
+          StructBinding<T>::template toJava<FrameLocalReferenceAllocator>(
+              values[i]);
+      array->setElement(i, element.get());
+    }
+  }
+  return array;
+}
+
+// convert to and from a bound struct and its Java object
+template <typename T>
+struct Convert<T, typename std::enable_if<IsJavaStruct<T>::value>::type> {
+  typedef typename JavaStruct<T>::JavaType::javaobject jniType;
+  static T fromJni(jniType t) {
+    return StructBinding<T>::fromJava(wrap_alias(t));
+  }
+  static jniType toJniRet(const T& t) {
+    return StructBinding<T>::toJava(t).release();
+  }
+  static local_ref<jniType> toCall(const T& t) {
+    return StructBinding<T>::toJava(t);
+  }
+};
+
+// convert to and from a vector of bound structs and a Java array
+template <typename T>
+struct Convert<
+    std::vector<T>,
+    typename std::enable_if<IsJavaStruct<T>::value>::type> {
+  typedef typename StructArray<T>::javaobject jniType;
+  static std::vector<T> fromJni(jniType t) {
+    return structsFromJava<T>(wrap_alias(t));
+  }
+  static jniType toJniRet(const std::vector<T>& t) {
+    return structsToJava(t).release();
+  }
+  static local_ref<jniType> toCall(const std::vector<T>& t) {
+    return structsToJava(t);
+  }
+};
+
+} // namespace detail
+
+} // namespace jni
+} // namespace facebook
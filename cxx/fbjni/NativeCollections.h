@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook {
+namespace jni {
+
+namespace detail {
+
+// Default conversions for the elements of native collections: strings become
+// Java Strings, primitives are boxed, and references are passed through.
+inline local_ref<jobject> toJavaElement(const std::string& value) {
+  return make_jstring(value);
+}
+
+template <typename T>
+auto toJavaElement(const T& value)
+    -> decltype(local_ref<jobject>(autobox(value))) {
+  return autobox(value);
+}
+
+// Converts map keys in both directions. Keys can be std::string or any
+// primitive type autobox() supports. A Java key of the wrong type is simply
+// not found, as it wouldn't be in a java.util.HashMap.
+template <typename K, typename Enable = void>
+struct NativeMapKey {
+  static_assert(
+      std::is_same<K, void>::value,
+      "NativeMap keys must be std::string or a primitive type");
+};
+
+template <>
+struct NativeMapKey<std::string> {
+  static bool fromJava(alias_ref<jobject> key, std::string& out) {
+    if (!key || !key->isInstanceOf(JString::javaClassStatic())) {
+      return false;
+    }
+    out = static_ref_cast<JString>(key)->toStdString();
+    return true;
+  }
+
+  static local_ref<jobject> toJava(const std::string& key) {
+    return make_jstring(key);
+  }
+};
+
+template <typename K>
+struct NativeMapKey<
+    K,
+    typename std::enable_if<std::is_arithmetic<K>::value>::type> {
+  using Boxed =
+      typename std::decay<decltype(*autobox(std::declval<K>()))>::type;
+
+  static bool fromJava(alias_ref<jobject> key, K& out) {
+    if (!key || !key->isInstanceOf(Boxed::javaClassStatic())) {
+      return false;
+    }
+    out = static_cast<K>(
+        static_ref_cast<typename Boxed::javaobject>(key)->value());
+    return true;
+  }
+
+  static local_ref<jobject> toJava(K key) {
+    return autobox(key);
+  }
+};
+
+class NativeListSource {
+ public:
+  virtual ~NativeListSource() = default;
+  virtual size_t size() const = 0;
+  virtual local_ref<jobject> get(size_t index) const = 0;
+};
+
+template <typename Container, typename F>
+class NativeListSourceImpl : public NativeListSource {
+ public:
+  NativeListSourceImpl(Container container, F convert)
+      : container_(std::move(container)), convert_(std::move(convert)) {}
+
+  size_t size() const override {
+    return container_.size();
+  }
+
+  local_ref<jobject> get(size_t index) const override {
+    return convert_(*std::next(container_.begin(), index));
+  }
+
+ private:
+  Container container_;
+  F convert_;
+};
+
+class NativeMapSource {
+ public:
+  virtual ~NativeMapSource() = default;
+  virtual size_t size() const = 0;
+  virtual bool contains(alias_ref<jobject> key) const = 0;
+  // Returns null if key isn't in the map.
+  virtual local_ref<jobject> get(alias_ref<jobject> key) const = 0;
+  virtual local_ref<jobject> keyAt(size_t index) const = 0;
+  virtual local_ref<jobject> valueAt(size_t index) const = 0;
+};
+
+template <typename Map, typename F>
+class NativeMapSourceImpl : public NativeMapSource {
+ public:
+  using Key = typename Map::key_type;
+
+  NativeMapSourceImpl(Map map, F convert)
+      : map_(std::move(map)), convert_(std::move(convert)) {}
+
+  size_t size() const override {
+    return map_.size();
+  }
+
+  bool contains(alias_ref<jobject> key) const override {
+    Key nativeKey;
+    return NativeMapKey<Key>::fromJava(key, nativeKey) &&
+        map_.find(nativeKey) != map_.end();
+  }
+
+  local_ref<jobject> get(alias_ref<jobject> key) const override {
+    Key nativeKey;
+    if (!NativeMapKey<Key>::fromJava(key, nativeKey)) {
+      return nullptr;
+    }
+    auto it = map_.find(nativeKey);
+    return it == map_.end() ? nullptr : convert_(it->second);
+  }
+
+  local_ref<jobject> keyAt(size_t index) const override {
+    return NativeMapKey<Key>::toJava(entry(index)->first);
+  }
+
+  local_ref<jobject> valueAt(size_t index) const override {
+    return convert_(entry(index)->second);
+  }
+
+ private:
+  // Java walks the entries by position, which hash maps can't look up
+  // directly, so the entries are indexed the first time that happens.
+  typename Map::const_iterator entry(size_t index) const {
+    std::call_once(indexed_, [this] {
+      entries_.reserve(map_.size());
+      for (auto it = map_.begin(); it != map_.end(); ++it) {
+        entries_.push_back(it);
+      }
+    });
+    return entries_[index];
+  }
+
+  Map map_;
+  F convert_;
+  mutable std::once_flag indexed_;
+  mutable std::vector<typename Map::const_iterator> entries_;
+};
+
+} // namespace detail
+
+/**
+ * A read-only java.util.List backed by a C++ container, which is moved (or
+ * copied) into the list's native part. Elements are converted to Java objects
+ * each time Java reads them, so returning a large container to Java that only
+ * reads part of it doesn't pay to convert all of it:
+ *
+ * std::vector<std::string> names = ...;
+ * return JNativeList::create(std::move(names));
+ *
+ * By default std::strings become Strings and primitives are boxed. Pass
+ * convert (taking a const element reference and returning a local_ref) to
+ * convert elements some other way. Elements are looked up with std::next, so
+ * containers should be random access.
+ */
+struct JNativeList : public HybridClass<JNativeList, JList<>> {
+ public:
+  static auto constexpr kJavaDescriptor = "Lcom/facebook/jni/NativeList;";
+
+  template <typename Container, typename F>
+  static local_ref<javaobject> create(Container&& container, F&& convert) {
+    using Source = detail::NativeListSourceImpl<
+        typename std::decay<Container>::type,
+        typename std::decay<F>::type>;
+    return newObjectCxxArgs(
+        std::unique_ptr<detail::NativeListSource>(new Source(
+            std::forward<Container>(container), std::forward<F>(convert))));
+  }
+
+  template <typename Container>
+  static local_ref<javaobject> create(Container&& container) {
+    using Element = typename std::decay<Container>::type::value_type;
+    return create(
+        std::forward<Container>(container),
+        [](const Element& element) -> local_ref<jobject> {
+          return detail::toJavaElement(element);
+        });
+  }
+
+  explicit JNativeList(std::unique_ptr<detail::NativeListSource> source)
+      : source_(std::move(source)) {}
+
+  static void OnLoad() {
+    registerHybrid({
+        makeNativeMethod("nativeSize", JNativeList::size),
+        makeNativeMethod("nativeGet", JNativeList::get),
+    });
+  }
+
+  jint size() {
+    return static_cast<jint>(source_->size());
+  }
+
+  local_ref<jobject> get(jint index) {
+    return source_->get(static_cast<size_t>(index));
+  }
+
+ private:
+  std::unique_ptr<detail::NativeListSource> source_;
+};
+
+/**
+ * A read-only java.util.Map backed by a C++ map (usually an
+ * std::unordered_map), which is moved (or copied) into the map's native part.
+ * get() and containsKey() look the key up in the C++ map, and values are
+ * converted only when Java reads them. Keys must be std::string or
+ * primitives; values are converted as for JNativeList.
+ */
+struct JNativeMap : public HybridClass<JNativeMap, JMap<>> {
+ public:
+  static auto constexpr kJavaDescriptor = "Lcom/facebook/jni/NativeMap;";
+
+  template <typename Map, typename F>
+  static local_ref<javaobject> create(Map&& map, F&& convertValue) {
+    using Source = detail::NativeMapSourceImpl<
+        typename std::decay<Map>::type,
+        typename std::decay<F>::type>;
+    return newObjectCxxArgs(std::unique_ptr<detail::NativeMapSource>(
+        new Source(std::forward<Map>(map), std::forward<F>(convertValue))));
+  }
+
+  template <typename Map>
+  static local_ref<javaobject> create(Map&& map) {
+    using Value = typename std::decay<Map>::type::mapped_type;
+    return create(
+        std::forward<Map>(map), [](const Value& value) -> local_ref<jobject> {
+          return detail::toJavaElement(value);
+        });
+  }
+
+  explicit JNativeMap(std::unique_ptr<detail::NativeMapSource> source)
+      : source_(std::move(source)) {}
+
+  static void OnLoad() {
+    registerHybrid({
+        makeNativeMethod("nativeSize", JNativeMap::size),
+        makeNativeMethod("nativeContainsKey", JNativeMap::containsKey),
+        makeNativeMethod("nativeGet", JNativeMap::get),
+        makeNativeMethod("nativeKeyAt", JNativeMap::keyAt),
+        makeNativeMethod("nativeValueAt", JNativeMap::valueAt),
+    });
+  }
+
+  jint size() {
+    return static_cast<jint>(source_->size());
+  }
+
+  jboolean containsKey(alias_ref<jobject> key) {
+    return source_->contains(key);
+  }
+
+  local_ref<jobject> get(alias_ref<jobject> key) {
+    return source_->get(key);
+  }
+
+  local_ref<jobject> keyAt(jint index) {
+    return source_->keyAt(static_cast<size_t>(index));
+  }
+
+  local_ref<jobject> valueAt(jint index) {
+    return source_->valueAt(static_cast<size_t>(index));
+  }
+
+ private:
+  std::unique_ptr<detail::NativeMapSource> source_;
+};
+
+} // namespace jni
+} // namespace facebook
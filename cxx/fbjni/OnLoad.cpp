@@ -14,15 +14,30 @@
  * limitations under the License.
  */
 
+#include <fbjni/CommandQueue.h>
+#include <fbjni/CompletableFuture.h>
+#include <fbjni/EventRing.h>
+#include <fbjni/Executor.h>
+#include <fbjni/NativeCollections.h>
 #include <fbjni/NativeRunnable.h>
 #include <fbjni/fbjni.h>
 
 using namespace facebook::jni;
 
+void facebook::jni::registerFbjniNatives() {
+  HybridDataOnLoad();
+  JNativeRunnable::OnLoad();
+  JNativeList::OnLoad();
+  JNativeMap::OnLoad();
+  JEventRing::OnLoad();
+  JCommandQueue::OnLoad();
+  JNativeBiConsumer::OnLoad();
+  JNativeTaskBatch::OnLoad();
+  ThreadScope::OnLoad();
+}
+
+#ifndef FBJNI_STATIC
 JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void* reserved) {
-  return facebook::jni::initialize(vm, [] {
-    HybridDataOnLoad();
-    JNativeRunnable::OnLoad();
-    ThreadScope::OnLoad();
-  });
+  return facebook::jni::initialize(vm, [] { registerFbjniNatives(); });
 }
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace facebook {
+namespace jni {
+
+template <typename K, typename V, typename F>
+auto toUnorderedMap(alias_ref<JMap<K, V>> map, F&& convertValue)
+    -> std::unordered_map<
+        std::string,
+        typename std::decay<decltype(convertValue(
+            std::declval<alias_ref<V>>()))>::type> {
+  static_assert(
+      std::is_same<JniType<K>, jstring>::value, "Map keys must be strings");
+  auto flattened = detail::flattenStringMap(map, false);
+  std::unordered_map<
+      std::string,
+      typename std::decay<decltype(convertValue(
+          std::declval<alias_ref<V>>()))>::type>
+      result;
+  result.reserve(flattened.keys.size());
+  for (size_t i = 0; i < flattened.keys.size(); ++i) {
+    auto value = detail::castCollectionElement<V>(
+        flattened.valueObjects->getElement(i));
+    result.emplace(std::move(flattened.keys[i]), convertValue(value));
+  }
+  return result;
+}
+
+template <typename K, typename V>
+std::unordered_map<std::string, std::string> toUnorderedMap(
+    alias_ref<JMap<K, V>> map) {
+  static_assert(
+      std::is_same<JniType<K>, jstring>::value &&
+          std::is_same<JniType<V>, jstring>::value,
+      "Map keys and values must be strings");
+  auto flattened = detail::flattenStringMap(map, true);
+  std::unordered_map<std::string, std::string> result;
+  result.reserve(flattened.keys.size());
+  for (size_t i = 0; i < flattened.keys.size(); ++i) {
+    result.emplace(
+        std::move(flattened.keys[i]), std::move(flattened.values[i]));
+  }
+  return result;
+}
+
+template <typename E>
+std::vector<std::string>
+toStringVector(alias_ref<JList<E>> list, size_t fromIndex, size_t toIndex) {
+  static_assert(
+      std::is_same<JniType<E>, jstring>::value,
+      "List elements must be strings");
+  return detail::joinedListStrings(
+      list, static_cast<jint>(fromIndex), static_cast<jint>(toIndex));
+}
+
+template <typename E>
+std::vector<std::string> toStringVector(alias_ref<JList<E>> list) {
+  static_assert(
+      std::is_same<JniType<E>, jstring>::value,
+      "List elements must be strings");
+  return detail::joinedListStrings(list, 0, -1);
+}
+
+template <typename V, typename T, typename F>
+local_ref<JHashMap<jstring, V>> toJavaHashMap(
+    const std::unordered_map<std::string, T>& map,
+    F&& convertValue) {
+  detail::StringJoiner keys(map.size());
+  auto values = JArrayClass<jobject>::newArray(map.size());
+  size_t i = 0;
+  for (const auto& entry : map) {
+    keys.add(entry.first);
+    values->setElement(i++, convertValue(entry.second).get());
+  }
+  jobject result = detail::buildMap(keys, values).release();
+  return adopt_local(
+      static_cast<typename JHashMap<jstring, V>::javaobject>(result));
+}
+
+} // namespace jni
+} // namespace facebook
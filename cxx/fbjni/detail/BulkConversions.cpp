@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fbjni/detail/utf8.h>
+#include <fbjni/fbjni.h>
+
+namespace facebook {
+namespace jni {
+
+namespace detail {
+
+namespace {
+
+// Takes ownership of an element of the Object[] returned by CollectionHelper,
+// whose type is known from the helper's contract.
+template <typename T>
+local_ref<T> takeElement(alias_ref<JArrayClass<jobject>> array, size_t idx) {
+  return adopt_local(
+      static_cast<JniType<T>>(array->getElement(idx).release()));
+}
+
+} // namespace
+
+std::vector<std::string> splitJoinedString(
+    alias_ref<JString> joined,
+    alias_ref<JArrayInt> ends) {
+  auto count = static_cast<jsize>(ends->size());
+  std::vector<jint> offsets(count);
+  if (count > 0) {
+    ends->getRegion(0, count, offsets.data());
+  }
+
+  std::vector<std::string> parts;
+  parts.reserve(count);
+  const auto env = Environment::current();
+  JStringUtf16Extractor chars(env, joined.get());
+  auto utf16 = reinterpret_cast<const uint16_t*>(chars.chars());
+  jint start = 0;
+  for (auto end : offsets) {
+    parts.push_back(utf16toUTF8(utf16 + start, end - start));
+    start = end;
+  }
+  return parts;
+}
+
+StringJoiner::StringJoiner(size_t count) {
+  ends_.reserve(count);
+}
+
+void StringJoiner::add(const std::string& str) {
+  utf8toUTF16(
+      reinterpret_cast<const uint8_t*>(str.data()), str.size(), chars_);
+  ends_.push_back(static_cast<jint>(chars_.size()));
+}
+
+local_ref<JString> StringJoiner::joined() const {
+  const auto env = Environment::current();
+  static_assert(
+      sizeof(jchar) == sizeof(std::u16string::value_type),
+      "Expecting jchar to be the same size as std::u16string::CharT");
+  jstring result = env->NewString(
+      reinterpret_cast<const jchar*>(chars_.data()), chars_.size());
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
+  return adopt_local(result);
+}
+
+local_ref<JArrayInt> StringJoiner::ends() const {
+  auto result = make_int_array(static_cast<jsize>(ends_.size()));
+  if (!ends_.empty()) {
+    result->setRegion(0, static_cast<jsize>(ends_.size()), ends_.data());
+  }
+  return result;
+}
+
+local_ref<JArrayClass<jstring>> toJavaStringArray(const StringJoiner& strings) {
+  static const auto splitMethod =
+      JCollectionHelper::javaClassStatic()
+          ->getStaticMethod<JArrayClass<jstring>::javaobject(
+              alias_ref<JString>, alias_ref<JArrayInt>)>("splitStrings");
+  return splitMethod(
+      JCollectionHelper::javaClassStatic(), strings.joined(), strings.ends());
+}
+
+FlattenedStringMap flattenStringMap(alias_ref<jobject> map, bool joinValues) {
+  static const auto flattenMethod =
+      JCollectionHelper::javaClassStatic()
+          ->getStaticMethod<JArrayClass<jobject>::javaobject(
+              alias_ref<JMap<>>, jboolean)>("flattenStringMap");
+  auto parts = flattenMethod(
+      JCollectionHelper::javaClassStatic(),
+      static_ref_cast<JMap<>>(map),
+      joinValues);
+
+  FlattenedStringMap result;
+  result.keys = splitJoinedString(
+      takeElement<jstring>(parts, 0), takeElement<jintArray>(parts, 1));
+  if (joinValues) {
+    result.values = splitJoinedString(
+        takeElement<jstring>(parts, 2), takeElement<jintArray>(parts, 3));
+  } else {
+    result.valueObjects = takeElement<JArrayClass<jobject>>(parts, 2);
+  }
+  return result;
+}
+
+std::vector<std::string>
+joinedListStrings(alias_ref<jobject> list, jint fromIndex, jint toIndex) {
+  static const auto joinMethod =
+      JCollectionHelper::javaClassStatic()
+          ->getStaticMethod<JArrayClass<jobject>::javaobject(
+              alias_ref<JList<>>, jint, jint)>("joinStrings");
+  auto parts = joinMethod(
+      JCollectionHelper::javaClassStatic(),
+      static_ref_cast<JList<>>(list),
+      fromIndex,
+      toIndex);
+  return splitJoinedString(
+      takeElement<jstring>(parts, 0), takeElement<jintArray>(parts, 1));
+}
+
+local_ref<JHashMap<jstring, jobject>> buildMap(
+    const StringJoiner& keys,
+    alias_ref<JArrayClass<jobject>> values) {
+  static const auto buildMethod =
+      JCollectionHelper::javaClassStatic()
+          ->getStaticMethod<JHashMap<jstring, jobject>::javaobject(
+              alias_ref<JString>,
+              alias_ref<JArrayInt>,
+              alias_ref<JArrayClass<jobject>>)>("buildMap");
+  return buildMethod(
+      JCollectionHelper::javaClassStatic(),
+      keys.joined(),
+      keys.ends(),
+      values);
+}
+
+} // namespace detail
+
+std::vector<std::string> toStringVector(
+    alias_ref<JArrayClass<jstring>> array) {
+  static const auto joinMethod =
+      detail::JCollectionHelper::javaClassStatic()
+          ->getStaticMethod<JArrayClass<jobject>::javaobject(
+              alias_ref<JArrayClass<jstring>>)>("joinStringArray");
+  auto parts =
+      joinMethod(detail::JCollectionHelper::javaClassStatic(), array);
+  return detail::splitJoinedString(
+      detail::takeElement<jstring>(parts, 0),
+      detail::takeElement<jintArray>(parts, 1));
+}
+
+local_ref<JArrayClass<jstring>> toJavaStringArray(
+    const std::vector<std::string>& strings) {
+  detail::StringJoiner joiner(strings.size());
+  for (const auto& str : strings) {
+    joiner.add(str);
+  }
+  return detail::toJavaStringArray(joiner);
+}
+
+local_ref<JHashMap<jstring, jstring>> toJavaHashMap(
+    const std::unordered_map<std::string, std::string>& map) {
+  static const auto buildMethod =
+      detail::JCollectionHelper::javaClassStatic()
+          ->getStaticMethod<JHashMap<jstring, jstring>::javaobject(
+              alias_ref<JString>,
+              alias_ref<JArrayInt>,
+              alias_ref<JString>,
+              alias_ref<JArrayInt>)>("buildStringMap");
+  detail::StringJoiner keys(map.size());
+  detail::StringJoiner values(map.size());
+  for (const auto& entry : map) {
+    keys.add(entry.first);
+    values.add(entry.second);
+  }
+  return buildMethod(
+      detail::JCollectionHelper::javaClassStatic(),
+      keys.joined(),
+      keys.ends(),
+      values.joined(),
+      values.ends());
+}
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file BulkConversions.h
+ *
+ * Conversions between Java collections and C++ containers which call into
+ * Java a constant number of times per collection, rather than once or more per
+ * element. Strings travel as one joined string plus the offset just past each
+ * part, so a thousand keys cost one string copy instead of a thousand. Values
+ * that stay Java objects still take an array read or write each.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreClasses.h"
+#include "Iterator.h"
+
+namespace facebook {
+namespace jni {
+
+/**
+ * Copies a java.util.Map with String keys into an std::unordered_map.
+ * convertValue is called with an alias_ref<V> to each value, and its result is
+ * stored under the key. For example:
+ *
+ * alias_ref<JMap<jstring, JInteger>> jmap = ...;
+ * auto counts = toUnorderedMap(
+ *     jmap, [](alias_ref<JInteger> count) { return count->intValue(); });
+ *
+ * Apart from the calls convertValue makes, this reads the whole map with a
+ * constant number of Java method calls, plus an array read and an instanceof
+ * check per value. Values which are not instances of V throw a
+ * ClassCastException, and null keys throw a NullPointerException.
+ */
+template <typename K, typename V, typename F>
+auto toUnorderedMap(alias_ref<JMap<K, V>> map, F&& convertValue)
+    -> std::unordered_map<
+        std::string,
+        typename std::decay<decltype(convertValue(
+            std::declval<alias_ref<V>>()))>::type>;
+
+/**
+ * Copies a java.util.Map with String keys and values into an
+ * std::unordered_map, with a constant number of Java method calls. Null keys
+ * or values throw a NullPointerException.
+ */
+template <typename K, typename V>
+std::unordered_map<std::string, std::string> toUnorderedMap(
+    alias_ref<JMap<K, V>> map);
+
+/**
+ * Builds a java.util.HashMap, sized to hold every entry without rehashing,
+ * from an std::unordered_map with string keys. convertValue is called with
+ * each value and must return a reference (usually a local_ref) to the Java
+ * value to store. Apart from the calls convertValue makes, the keys and the
+ * map cost a constant number of Java method calls, and each value an array
+ * write to store it.
+ */
+template <typename V = jobject, typename T, typename F>
+local_ref<JHashMap<jstring, V>> toJavaHashMap(
+    const std::unordered_map<std::string, T>& map,
+    F&& convertValue);
+
+/**
+ * Builds a java.util.HashMap of Strings from an std::unordered_map of strings,
+ * with a constant number of Java method calls.
+ */
+local_ref<JHashMap<jstring, jstring>> toJavaHashMap(
+    const std::unordered_map<std::string, std::string>& map);
+
+/**
+ * Copies the Strings in a java.util.List from fromIndex to toIndex into a
+ * vector, with a constant number of Java method calls.  Null elements throw a
+ * NullPointerException, and other non-Strings a ClassCastException.
+ */
+template <typename E>
+std::vector<std::string>
+toStringVector(alias_ref<JList<E>> list, size_t fromIndex, size_t toIndex);
+
+/**
+ * Copies every String in a java.util.List into a vector, as above.
+ */
+template <typename E>
+std::vector<std::string> toStringVector(alias_ref<JList<E>> list);
+
+/**
+ * Copies a String[] into a vector with a constant number of Java method
+ * calls.  Null elements throw a NullPointerException.
+ */
+std::vector<std::string> toStringVector(
+    alias_ref<JArrayClass<jstring>> array);
+
+/**
+ * Builds a String[] from a vector of strings with a constant number of Java
+ * method calls.
+ */
+local_ref<JArrayClass<jstring>> toJavaStringArray(
+    const std::vector<std::string>& strings);
+
+namespace detail {
+
+struct JCollectionHelper : JavaClass<JCollectionHelper> {
+  static constexpr auto kJavaDescriptor = "Lcom/facebook/jni/CollectionHelper;";
+};
+
+/// Splits a string joined on the Java side. ends holds the UTF-16 offset just
+/// past each part.
+std::vector<std::string> splitJoinedString(
+    alias_ref<JString> joined,
+    alias_ref<JArrayInt> ends);
+
+/// Joins strings into the form splitJoinedString reads, for the Java side to
+/// split.
+class StringJoiner {
+ public:
+  explicit StringJoiner(size_t count);
+
+  void add(const std::string& str);
+
+  local_ref<JString> joined() const;
+  local_ref<JArrayInt> ends() const;
+
+ private:
+  std::u16string chars_;
+  std::vector<jint> ends_;
+};
+
+/// Splits joined strings into a String[] on the Java side.
+local_ref<JArrayClass<jstring>> toJavaStringArray(const StringJoiner& strings);
+
+/// The result of CollectionHelper.flattenStringMap. When the values were
+/// joined, values holds them; otherwise valueObjects does.
+struct FlattenedStringMap {
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  local_ref<JArrayClass<jobject>> valueObjects;
+};
+
+FlattenedStringMap flattenStringMap(alias_ref<jobject> map, bool joinValues);
+
+/// Reads list elements from fromIndex to toIndex, or to the end of the list if
+/// toIndex is negative.
+std::vector<std::string>
+joinedListStrings(alias_ref<jobject> list, jint fromIndex, jint toIndex);
+
+local_ref<JHashMap<jstring, jobject>> buildMap(
+    const StringJoiner& keys,
+    alias_ref<JArrayClass<jobject>> values);
+
+} // namespace detail
+
+} // namespace jni
+} // namespace facebook
+
+#include "BulkConversions-inl.h"
@@ -34,9 +34,10 @@
 #endif
 
 // If a pending JNI Java exception is found, wraps it in a JniException object
-// and throws it as a C++ exception.
-#define FACEBOOK_JNI_THROW_PENDING_EXCEPTION() \
-  ::facebook::jni::throwPendingJniExceptionAsCppException()
+// and throws it as a C++ exception. Callers that already have the JNIEnv should
+// pass it: the check is then inlined, and only the throw is out of line.
+#define FACEBOOK_JNI_THROW_PENDING_EXCEPTION(...) \
+  ::facebook::jni::throwPendingJniExceptionAsCppException(__VA_ARGS__)
 
 // If the condition is true, throws a JniException object, which wraps the
 // pending JNI Java exception if any. If no pending exception is found, throws a
@@ -49,7 +50,29 @@
 namespace facebook {
 namespace jni {
 
+#if defined(__GNUC__)
+#define FBJNI_UNLIKELY(CONDITION) __builtin_expect(!!(CONDITION), 0)
+#define FBJNI_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define FBJNI_UNLIKELY(CONDITION) (CONDITION)
+#define FBJNI_COLD __declspec(noinline)
+#else
+#define FBJNI_UNLIKELY(CONDITION) (CONDITION)
+#define FBJNI_COLD
+#endif
+
+namespace detail {
+[[noreturn]] FBJNI_COLD void throwPendingJniException(JNIEnv* env);
+} // namespace detail
+
 void throwPendingJniExceptionAsCppException();
+
+inline void throwPendingJniExceptionAsCppException(JNIEnv* env) {
+  if (FBJNI_UNLIKELY(env->ExceptionCheck() != JNI_FALSE)) {
+    detail::throwPendingJniException(env);
+  }
+}
+
 void throwCppExceptionIf(bool condition);
 
 [[noreturn]] void throwNewJavaException(jthrowable);
@@ -77,6 +100,14 @@ throwNewJavaException(const char* throwableName, const char* fmt, Args... args);
  */
 jint initialize(JavaVM*, std::function<void()>&&) noexcept;
 
+/**
+ * Registers the natives of fbjni's own Java classes. libfbjni's JNI_OnLoad
+ * does this; when fbjni is built as a static library (FBJNI_STATIC) it has
+ * no JNI_OnLoad, and the library it is linked into must call this from its
+ * initialize() callback instead.
+ */
+void registerFbjniNatives();
+
 namespace internal {
 
 // Define to get extremely verbose logging of references and to enable reference
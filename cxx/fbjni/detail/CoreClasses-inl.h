@@ -22,6 +22,7 @@
 
 #include "Common.h"
 #include "Exceptions.h"
+#include "IdRegistry.h"
 #include "Meta.h"
 #include "MetaConvert.h"
 
@@ -202,9 +203,13 @@ inline JMethod<F> JClass::getMethod(const char* name) const {
 template <typename F>
 inline JMethod<F> JClass::getMethod(const char* name, const char* descriptor)
     const {
+#ifdef FBJNI_SHARED_REGISTRY
+  const auto method = detail::sharedMethodId(self(), name, descriptor, false);
+#else
   const auto env = Environment::current();
   const auto method = env->GetMethodID(self(), name, descriptor);
   FACEBOOK_JNI_THROW_EXCEPTION_IF(!method);
+#endif
   return JMethod<F>{method};
 }
 
@@ -218,9 +223,13 @@ template <typename F>
 inline JStaticMethod<F> JClass::getStaticMethod(
     const char* name,
     const char* descriptor) const {
+#ifdef FBJNI_SHARED_REGISTRY
+  const auto method = detail::sharedMethodId(self(), name, descriptor, true);
+#else
   const auto env = Environment::current();
   const auto method = env->GetStaticMethodID(self(), name, descriptor);
   FACEBOOK_JNI_THROW_EXCEPTION_IF(!method);
+#endif
   return JStaticMethod<F>{method};
 }
 
@@ -235,9 +244,13 @@ template <typename F>
 inline JNonvirtualMethod<F> JClass::getNonvirtualMethod(
     const char* name,
     const char* descriptor) const {
+#ifdef FBJNI_SHARED_REGISTRY
+  const auto method = detail::sharedMethodId(self(), name, descriptor, false);
+#else
   const auto env = Environment::current();
   const auto method = env->GetMethodID(self(), name, descriptor);
   FACEBOOK_JNI_THROW_EXCEPTION_IF(!method);
+#endif
   return JNonvirtualMethod<F>{method};
 }
 
@@ -250,9 +263,13 @@ template <typename T>
 inline JField<PrimitiveOrJniType<T>> JClass::getField(
     const char* name,
     const char* descriptor) const {
+#ifdef FBJNI_SHARED_REGISTRY
+  const auto field = detail::sharedFieldId(self(), name, descriptor, false);
+#else
   const auto env = Environment::current();
   auto field = env->GetFieldID(self(), name, descriptor);
   FACEBOOK_JNI_THROW_EXCEPTION_IF(!field);
+#endif
   return JField<PrimitiveOrJniType<T>>{field};
 }
 
@@ -266,9 +283,13 @@ template <typename T>
 inline JStaticField<PrimitiveOrJniType<T>> JClass::getStaticField(
     const char* name,
     const char* descriptor) const {
+#ifdef FBJNI_SHARED_REGISTRY
+  const auto field = detail::sharedFieldId(self(), name, descriptor, true);
+#else
   const auto env = Environment::current();
   auto field = env->GetStaticFieldID(self(), name, descriptor);
   FACEBOOK_JNI_THROW_EXCEPTION_IF(!field);
+#endif
   return JStaticField<PrimitiveOrJniType<T>>{field};
 }
 
@@ -55,6 +55,9 @@ jclass findClass(JNIEnv* env, const char* name);
 /// The most common use case for this is storing the result
 /// in a "static auto" variable, or a static global.
 ///
+/// With FBJNI_SHARED_REGISTRY, every call for a name returns the same
+/// reference, across all libraries using fbjni (see IdRegistry.h).
+///
 /// @return Returns a leaked global reference to the class
 alias_ref<JClass> findClassStatic(const char* name);
 
@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <cstdlib>
+#include <exception>
 #include <ios>
 #include <stdexcept>
 #include <string>
@@ -145,12 +146,7 @@ void setJavaExceptionAndAbortOnFailure(alias_ref<JThrowable> throwable) {
 // the c++ stack and then insert it into the correct place in the java stack
 // trace. Then, as the exception propagates across the boundaries, we will
 // slowly fill in the c++ parts of the trace.
-void throwPendingJniExceptionAsCppException() {
-  JNIEnv* env = Environment::current();
-  if (env->ExceptionCheck() == JNI_FALSE) {
-    return;
-  }
-
+void detail::throwPendingJniException(JNIEnv* env) {
   auto throwable = env->ExceptionOccurred();
   if (!throwable) {
     throw std::runtime_error("Unable to get pending JNI exception.");
@@ -160,6 +156,49 @@ void throwPendingJniExceptionAsCppException() {
   throw JniException(adopt_local(throwable));
 }
 
+void throwPendingJniExceptionAsCppException() {
+  throwPendingJniExceptionAsCppException(Environment::current());
+}
+
+namespace {
+
+int uncaughtExceptionCount() noexcept {
+#if __cplusplus >= 201703L || defined(__cpp_lib_uncaught_exceptions)
+  return std::uncaught_exceptions();
+#else
+  return 0;
+#endif
+}
+
+// Whether an exception thrown since uncaughtExceptionCount() returned count
+// is unwinding the stack.
+bool unwindingSince(int count) noexcept {
+#if __cplusplus >= 201703L || defined(__cpp_lib_uncaught_exceptions)
+  return std::uncaught_exceptions() > count;
+#else
+  // Without a count, any exception in flight has to be assumed to be new.
+  (void)count;
+  return std::uncaught_exception();
+#endif
+}
+
+} // namespace
+
+UncheckedScope::UncheckedScope() noexcept
+    : uncaughtExceptions_(uncaughtExceptionCount()) {}
+
+UncheckedScope::~UncheckedScope() noexcept(false) {
+  if (unwindingSince(uncaughtExceptions_)) {
+    Environment::current()->ExceptionClear();
+    return;
+  }
+  check();
+}
+
+void UncheckedScope::check() const {
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+}
+
 void throwCppExceptionIf(bool condition) {
   if (!condition) {
     return;
@@ -167,8 +206,7 @@ void throwCppExceptionIf(bool condition) {
 
   auto env = Environment::current();
   if (env->ExceptionCheck() == JNI_TRUE) {
-    throwPendingJniExceptionAsCppException();
-    return;
+    detail::throwPendingJniException(env);
   }
 
   throw JniException();
@@ -33,6 +33,7 @@
 
 #include <jni.h>
 
+#include <fbjni/detail/FbjniApi.h>
 #include "Common.h"
 #include "CoreClasses.h"
 #include "References.h"
@@ -74,7 +75,7 @@ class JCppException : public JavaClass<JCppException, JThrowable> {
  *
  * Note: the what() method of this class is not thread-safe (t6900503).
  */
-class JniException : public std::exception {
+class FBJNI_API JniException : public std::exception {
  public:
   JniException();
   ~JniException() override;
@@ -99,6 +100,41 @@ class JniException : public std::exception {
   void populateWhat() const noexcept;
 };
 
+// UncheckedScope
+// ////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Defers the pending exception check after Java method calls made with
+ * unchecked(), so that a run of calls costs one ExceptionCheck instead of one
+ * per call:
+ *
+ *   UncheckedScope scope;
+ *   auto x = getX.unchecked(scope, point);
+ *   auto y = getY.unchecked(scope, point);
+ *   scope.check(); // Optional, the destructor checks too.
+ *
+ * Only use it for methods that can't throw, like getters on our own classes.
+ * While a Java exception is pending, JNI allows little more than handling it,
+ * so a call made after one that threw is undefined behavior (CheckJNI aborts).
+ *
+ * The destructor throws the pending exception as a JniException, unless the
+ * scope is left because of another C++ exception, in which case the Java
+ * exception is cleared.
+ */
+class UncheckedScope {
+ public:
+  UncheckedScope() noexcept;
+  UncheckedScope(const UncheckedScope&) = delete;
+  UncheckedScope& operator=(const UncheckedScope&) = delete;
+  ~UncheckedScope() noexcept(false);
+
+  /// Throws the pending Java exception, if any, as a JniException.
+  void check() const;
+
+ private:
+  int uncaughtExceptions_;
+};
+
 // Exception throwing & translating functions
 // //////////////////////////////////////////////////////
 
@@ -16,12 +16,17 @@
 
 #pragma once
 
-#ifdef _MSC_VER
-#ifdef BUILDING_FBJNI
+// Marks what must stay visible outside the library fbjni is built into. The
+// shared library exports everything anyway; a static build (FBJNI_STATIC)
+// hides everything else.
+#if defined(_MSC_VER)
+#if defined(FBJNI_STATIC)
+#define FBJNI_API
+#elif defined(BUILDING_FBJNI)
 #define FBJNI_API __declspec(dllexport)
 #else
 #define FBJNI_API __declspec(dllimport)
 #endif
 #else
-#define FBJNI_API
+#define FBJNI_API __attribute__((visibility("default")))
 #endif
@@ -78,10 +78,18 @@ void setNativePointer(
 
 // Inline rather than in cpp file so that consumers can call into
 // their own copy directly rather than into the DSO containing fbjni,
-// saving space for the symbol table.
+// saving space for the symbol table. With FBJNI_SHARED_REGISTRY, the field
+// is looked up on HybridData, where it is declared, so that the id is shared
+// by every hybrid class in every library.
 inline JField<HybridDestructor::javaobject> getDestructorField(
     const local_ref<JClass>& c) {
+#ifdef FBJNI_SHARED_REGISTRY
+  (void)c;
+  return HybridData::javaClassStatic()
+      ->template getField<HybridDestructor::javaobject>("mDestructor");
+#else
   return c->template getField<HybridDestructor::javaobject>("mDestructor");
+#endif
 }
 
 template <typename T>
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IdRegistry.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <fbjni/fbjni.h>
+
+namespace facebook {
+namespace jni {
+namespace detail {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  std::unordered_map<std::string, jclass> classes;
+  // The name each shared class was looked up by, which keys its members.
+  std::unordered_map<jclass, std::string> names;
+  std::unordered_map<std::string, jmethodID> methods;
+  std::unordered_map<std::string, jfieldID> fields;
+};
+
+// Holds global references for the life of the process, and is never
+// destroyed, so exit doesn't have to delete references without a JVM.
+Registry& registry() {
+  static auto& instance = *new Registry();
+  return instance;
+}
+
+std::string memberKey(
+    const std::string& className,
+    const char* name,
+    const char* descriptor,
+    bool isStatic) {
+  // Names can't contain ';', so it unambiguously separates them from each
+  // other and from the descriptor that ends the key.
+  std::string key(isStatic ? "S" : "I");
+  key += className;
+  key += ';';
+  key += name;
+  key += ';';
+  key += descriptor;
+  return key;
+}
+
+template <typename Id, typename Lookup>
+Id sharedMemberId(
+    std::unordered_map<std::string, Id>& ids,
+    jclass cls,
+    const char* name,
+    const char* descriptor,
+    bool isStatic,
+    Lookup&& lookup) {
+  auto& r = registry();
+  std::string key;
+  {
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto className = r.names.find(cls);
+    if (className != r.names.end()) {
+      key = memberKey(className->second, name, descriptor, isStatic);
+      auto it = ids.find(key);
+      if (it != ids.end()) {
+        return it->second;
+      }
+    }
+  }
+
+  // Looked up without the lock held, since looking up a static member
+  // initializes the class, which runs Java code that can come back here.
+  const auto id = lookup(Environment::current());
+  FACEBOOK_JNI_THROW_EXCEPTION_IF(!id);
+  if (!key.empty()) {
+    std::lock_guard<std::mutex> lock(r.mutex);
+    ids.emplace(std::move(key), id);
+  }
+  return id;
+}
+
+} // namespace
+
+jclass sharedClass(const char* name) {
+  auto& r = registry();
+  {
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto it = r.classes.find(name);
+    if (it != r.classes.end()) {
+      return it->second;
+    }
+  }
+
+  JNIEnv* env = currentOrNull();
+  auto cls = adopt_local(findClass(env, name));
+  auto global = make_global(cls);
+  std::lock_guard<std::mutex> lock(r.mutex);
+  // Another thread may have got here first, in which case ours is dropped.
+  auto result = r.classes.emplace(name, global.get());
+  if (result.second) {
+    r.names.emplace(global.get(), name);
+    global.release();
+  }
+  return result.first->second;
+}
+
+jmethodID sharedMethodId(
+    jclass cls,
+    const char* name,
+    const char* descriptor,
+    bool isStatic) {
+  return sharedMemberId(
+      registry().methods,
+      cls,
+      name,
+      descriptor,
+      isStatic,
+      [=](JNIEnv* env) {
+        return isStatic ? env->GetStaticMethodID(cls, name, descriptor)
+                        : env->GetMethodID(cls, name, descriptor);
+      });
+}
+
+jfieldID sharedFieldId(
+    jclass cls,
+    const char* name,
+    const char* descriptor,
+    bool isStatic) {
+  return sharedMemberId(
+      registry().fields,
+      cls,
+      name,
+      descriptor,
+      isStatic,
+      [=](JNIEnv* env) {
+        return isStatic ? env->GetStaticFieldID(cls, name, descriptor)
+                        : env->GetFieldID(cls, name, descriptor);
+      });
+}
+
+} // namespace detail
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include <fbjni/detail/FbjniApi.h>
+
+// A process-wide registry of classes and member ids, exported from libfbjni.
+//
+// Every library that includes fbjni otherwise resolves the classes and ids it
+// uses on its own: findClassStatic() leaks a global reference per call, and
+// the function-local statics holding method and field ids are per DSO. An
+// app with many JNI libraries repeats the same lookups for String, HybridData
+// and so on once in each of them.
+//
+// Define FBJNI_SHARED_REGISTRY (the CMake option of the same name does this
+// for fbjni and everything that links it) to route findClassStatic() and the
+// JClass member lookups through the registry, so each class, method and field
+// is resolved once for all DSOs. Call sites still keep the result in their
+// own statics, so only the first use in each DSO reaches the registry.
+//
+// Entries are never removed, so this is only appropriate for classes that are
+// never unloaded, as with findClassStatic().
+
+namespace facebook {
+namespace jni {
+namespace detail {
+
+// Returns a leaked global reference to the named class (in the form
+// "java/lang/String"). The first call for a name does the lookup; later calls
+// from any library return the same reference.
+FBJNI_API jclass sharedClass(const char* name);
+
+// Returns the id of a method of cls. When cls came from sharedClass(), the id
+// is looked up once per class, name and descriptor and shared from then on;
+// for any other class it is looked up every time.
+FBJNI_API jmethodID sharedMethodId(
+    jclass cls,
+    const char* name,
+    const char* descriptor,
+    bool isStatic);
+
+// As sharedMethodId(), for fields.
+FBJNI_API jfieldID sharedFieldId(
+    jclass cls,
+    const char* name,
+    const char* descriptor,
+    bool isStatic);
+
+} // namespace detail
+} // namespace jni
+} // namespace facebook
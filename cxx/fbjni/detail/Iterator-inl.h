@@ -21,6 +21,31 @@ namespace jni {
 
 namespace detail {
 
+// The Java helpers copy elements out of the underlying iterator this many at a
+// time, so walking a collection costs one JNI call per batch rather than
+// several per element.
+constexpr jint kIteratorBatchSize = 64;
+
+// Converts an element read out of a Java collection to the collection's
+// element type. Casting to jobject (or JObject) can't fail, so no check is
+// made at all. Otherwise an IsInstanceOf check against a cached class decides,
+// and failures go through dynamic_ref_cast so the ClassCastException reads the
+// same as it always has.
+template <typename E>
+local_ref<E> castCollectionElement(local_ref<jobject>&& element) {
+  if (std::is_same<JniType<E>, jobject>::value || !element) {
+    return adopt_local(static_cast<JniType<E>>(element.release()));
+  }
+  static alias_ref<jclass> elementClass =
+      findClassStatic(jtype_traits<E>::kBaseName.c_str());
+  if (elementClass &&
+      Environment::current()->IsInstanceOf(
+          element.get(), elementClass.get()) != JNI_FALSE) {
+    return adopt_local(static_cast<JniType<E>>(element.release()));
+  }
+  return dynamic_ref_cast<E>(element);
+}
+
 template <typename E>
 struct IteratorHelper : public JavaClass<IteratorHelper<E>> {
   constexpr static auto kJavaDescriptor = "Lcom/facebook/jni/IteratorHelper;";
@@ -33,16 +58,28 @@ struct IteratorHelper : public JavaClass<IteratorHelper<E>> {
 
   typedef JavaClass<IteratorHelper<E>> JavaBase_;
 
-  bool hasNext() const {
-    static auto hasNextMethod =
-        JavaBase_::javaClassStatic()->template getMethod<jboolean()>("hasNext");
-    return hasNextMethod(JavaBase_::self());
+  // Holds the most recently filled batch. Copies of an iterator share it
+  // until one of them refills, which then takes an array of its own, so a
+  // batch is never overwritten while another copy is still reading it.
+  struct Buffer {
+    shared_global_ref<JArrayClass<jobject>> elements;
+  };
+
+  // Refills the buffer from the Java iterator, and returns how many elements
+  // were read. A short batch means the iterator is exhausted.
+  jint fill(Buffer& buffer) const {
+    static auto fillMethod =
+        JavaBase_::javaClassStatic()
+            ->template getMethod<jint(alias_ref<JArrayClass<jobject>>)>("fill");
+    if (!buffer.elements || buffer.elements.use_count() > 1) {
+      buffer.elements = make_shared_global(
+          JArrayClass<jobject>::newArray(kIteratorBatchSize));
+    }
+    return fillMethod(JavaBase_::self(), buffer.elements);
   }
 
-  value_type next() {
-    static auto elementField =
-        JavaBase_::javaClassStatic()->template getField<jobject>("mElement");
-    return dynamic_ref_cast<E>(JavaBase_::getFieldValue(elementField));
+  static value_type get(Buffer& buffer, jint index) {
+    return castCollectionElement<E>(buffer.elements->getElement(index));
   }
 
   static void reset(value_type& v) {
@@ -59,20 +96,31 @@ struct MapIteratorHelper : public JavaClass<MapIteratorHelper<K, V>> {
 
   typedef JavaClass<MapIteratorHelper<K, V>> JavaBase_;
 
-  bool hasNext() const {
-    static auto hasNextMethod =
-        JavaBase_::javaClassStatic()->template getMethod<jboolean()>("hasNext");
-    return hasNextMethod(JavaBase_::self());
+  // As IteratorHelper::Buffer. The two arrays are always replaced together.
+  struct Buffer {
+    shared_global_ref<JArrayClass<jobject>> keys;
+    shared_global_ref<JArrayClass<jobject>> values;
+  };
+
+  jint fill(Buffer& buffer) const {
+    static auto fillMethod =
+        JavaBase_::javaClassStatic()
+            ->template getMethod<jint(
+                alias_ref<JArrayClass<jobject>>,
+                alias_ref<JArrayClass<jobject>>)>("fill");
+    if (!buffer.keys || buffer.keys.use_count() > 1) {
+      buffer.keys = make_shared_global(
+          JArrayClass<jobject>::newArray(kIteratorBatchSize));
+      buffer.values = make_shared_global(
+          JArrayClass<jobject>::newArray(kIteratorBatchSize));
+    }
+    return fillMethod(JavaBase_::self(), buffer.keys, buffer.values);
   }
 
-  value_type next() {
-    static auto keyField =
-        JavaBase_::javaClassStatic()->template getField<jobject>("mKey");
-    static auto valueField =
-        JavaBase_::javaClassStatic()->template getField<jobject>("mValue");
+  static value_type get(Buffer& buffer, jint index) {
     return std::make_pair(
-        dynamic_ref_cast<K>(JavaBase_::getFieldValue(keyField)),
-        dynamic_ref_cast<V>(JavaBase_::getFieldValue(valueField)));
+        castCollectionElement<K>(buffer.keys->getElement(index)),
+        castCollectionElement<V>(buffer.values->getElement(index)));
   }
 
   static void reset(value_type& v) {
@@ -81,6 +129,9 @@ struct MapIteratorHelper : public JavaClass<MapIteratorHelper<K, V>> {
   }
 };
 
+// An input iterator: copies keep their own position in the batch they were
+// copied with, but share the Java iterator behind them, so once one copy
+// refills, the next batch is no longer there for the others.
 template <typename T>
 class Iterator {
  public:
@@ -92,12 +143,16 @@ class Iterator {
 
   // begin ctor
   Iterator(global_ref<typename T::javaobject>&& helper)
-      : helper_(std::move(helper)), i_(-1) {
+      : helper_(std::move(helper)),
+        i_(-1),
+        count_(0),
+        next_(0),
+        exhausted_(false) {
     ++(*this);
   }
 
   // end ctor
-  Iterator() : i_(-1) {}
+  Iterator() : i_(-1), count_(0), next_(0), exhausted_(true) {}
 
   bool operator==(const Iterator& it) const {
     return i_ == it.i_;
@@ -114,13 +169,17 @@ class Iterator {
     return &entry_;
   }
   Iterator& operator++() { // preincrement
-    bool hasNext = helper_->hasNext();
-    if (hasNext) {
+    if (next_ == count_ && !exhausted_) {
+      count_ = helper_->fill(buffer_);
+      next_ = 0;
+      exhausted_ = count_ < kIteratorBatchSize;
+    }
+    if (next_ < count_) {
       ++i_;
-      entry_ = helper_->next();
+      entry_ = T::get(buffer_, next_++);
     } else {
       i_ = -1;
-      helper_->reset(entry_);
+      T::reset(entry_);
     }
     return *this;
   }
@@ -132,9 +191,14 @@ class Iterator {
     return ret;
   }
 
-  global_ref<T> helper_;
+  shared_global_ref<T> helper_;
+  typename T::Buffer buffer_;
   // set to -1 at end
   std::ptrdiff_t i_;
+  // number of elements in buffer_, and the index of the next one to read
+  jint count_;
+  jint next_;
+  bool exhausted_;
   value_type entry_;
 };
 
@@ -199,6 +263,66 @@ bool JCollection<E>::add(alias_ref<E> elem) {
   return addMethod(this->self(), elem);
 }
 
+template <typename E>
+local_ref<E> JList<E>::get(size_t index) const {
+  static auto getMethod =
+      JList<E>::javaClassStatic()->template getMethod<jobject(jint)>("get");
+  return detail::castCollectionElement<E>(
+      getMethod(this->self(), static_cast<jint>(index)));
+}
+
+template <typename E>
+local_ref<JObject> JList<E>::set(size_t index, alias_ref<E> elem) {
+  static auto setMethod =
+      JList<E>::javaClassStatic()
+          ->template getMethod<JObject(jint, alias_ref<JObject>)>("set");
+  return setMethod(this->self(), static_cast<jint>(index), elem);
+}
+
+template <typename E>
+local_ref<JList<E>> JList<E>::subList(size_t fromIndex, size_t toIndex)
+    const {
+  static auto subListMethod =
+      JList<E>::javaClassStatic()
+          ->template getMethod<typename JList<E>::javaobject(jint, jint)>(
+              "subList");
+  return subListMethod(
+      this->self(), static_cast<jint>(fromIndex), static_cast<jint>(toIndex));
+}
+
+template <typename E>
+local_ref<JArrayClass<jobject>> JList<E>::toArray() const {
+  static auto toArrayMethod =
+      JList<E>::javaClassStatic()
+          ->template getMethod<JArrayClass<jobject>::javaobject()>("toArray");
+  return toArrayMethod(this->self());
+}
+
+template <typename E>
+std::vector<local_ref<E>> JList<E>::copyRange(size_t fromIndex, size_t toIndex)
+    const {
+  return copyRange(
+      fromIndex, toIndex, [](local_ref<E>&& elem) { return std::move(elem); });
+}
+
+template <typename E>
+template <typename F>
+auto JList<E>::copyRange(size_t fromIndex, size_t toIndex, F&& convert) const
+    -> std::vector<typename std::decay<decltype(convert(
+        std::declval<local_ref<E>>()))>::type> {
+  auto elements = subList(fromIndex, toIndex)->toArray();
+  auto count = elements->size();
+  std::vector<typename std::decay<decltype(convert(
+      std::declval<local_ref<E>>()))>::type>
+      result;
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    result.push_back(
+        convert(detail::castCollectionElement<E>(elements->getElement(i))));
+  }
+  return result;
+}
+
 template <typename K, typename V>
 struct JMap<K, V>::Iterator
     : public detail::Iterator<detail::MapIteratorHelper<K, V>> {
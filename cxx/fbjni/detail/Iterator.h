@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "CoreClasses.h"
 
 namespace facebook {
@@ -108,6 +110,50 @@ struct JCollection : JavaClass<JCollection<E>, JIterable<E>> {
 template <typename E = jobject>
 struct JList : JavaClass<JList<E>, JCollection<E>> {
   constexpr static auto kJavaDescriptor = "Ljava/util/List;";
+
+  /**
+   * Returns the element at index.  Throws a java ClassCastException if it is
+   * not convertible to the element type, and IndexOutOfBoundsException if
+   * index is out of range.
+   */
+  local_ref<E> get(size_t index) const;
+
+  /**
+   * Replaces the element at index, and returns the element that was there.
+   */
+  local_ref<JObject> set(size_t index, alias_ref<E> elem);
+
+  /**
+   * Returns a view of the elements from fromIndex (inclusive) to toIndex
+   * (exclusive), backed by this list.
+   */
+  local_ref<JList<E>> subList(size_t fromIndex, size_t toIndex) const;
+
+  /**
+   * Copies the whole list into a new Object[] with a single call.
+   */
+  local_ref<JArrayClass<jobject>> toArray() const;
+
+  /**
+   * Copies the elements from fromIndex to toIndex into a vector.  The slice is
+   * fetched with two Java calls however long it is, and then costs an array
+   * read per element, plus a type check unless E is jobject.  Every element is
+   * returned as a local reference, so copying a long slice may need a larger
+   * local reference capacity (see JniLocalScope); converting the elements as
+   * they are read avoids that:
+   *
+   * auto names = jlist->copyRange(
+   *     0, 100, [](local_ref<jstring> s) { return s->toStdString(); });
+   *
+   * convert is called with each element as a local_ref<E>, which is released
+   * as soon as convert returns.  For lists of strings, toStringVector (in
+   * BulkConversions.h) is cheaper still.
+   */
+  std::vector<local_ref<E>> copyRange(size_t fromIndex, size_t toIndex) const;
+  template <typename F>
+  auto copyRange(size_t fromIndex, size_t toIndex, F&& convert) const
+      -> std::vector<typename std::decay<decltype(convert(
+          std::declval<local_ref<E>>()))>::type>;
 };
 
 template <typename E = jobject>
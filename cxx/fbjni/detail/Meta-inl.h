@@ -43,49 +43,91 @@ inline jmethodID JMethodBase::getId() const noexcept {
   return method_id_;
 }
 
-namespace {
+namespace detail {
+
+inline void setArg(jobjectArray array, int idx, jobject value) {
+  Environment::current()->SetObjectArrayElement(array, idx, value);
+}
+
+// Method.invoke only takes objects, so primitives still have to be boxed.
+template <typename T>
+inline enable_if_t<IsJniPrimitive<T>(), void>
+setArg(jobjectArray array, int idx, T value) {
+  setArg(array, idx, autobox(value).get());
+}
 
 template <int idx, typename... Args>
 struct ArgsArraySetter;
 
 template <int idx, typename Arg, typename... Args>
 struct ArgsArraySetter<idx, Arg, Args...> {
-  static void
-  set(alias_ref<JArrayClass<jobject>> array, Arg arg0, Args... args) {
-    // TODO(xxxxxxxx): Use Convert<Args>... to do conversions like the fast
-    // path.
-    (*array)[idx] = autobox(arg0);
+  static void set(jobjectArray array, Arg arg0, Args... args) {
+    // References go in as they are; only primitives are boxed.
+    setArg(
+        array,
+        idx,
+        callToJni(Convert<typename std::decay<Arg>::type>::toCall(arg0)));
     ArgsArraySetter<idx + 1, Args...>::set(array, args...);
   }
 };
 
 template <int idx>
 struct ArgsArraySetter<idx> {
-  static void set(alias_ref<JArrayClass<jobject>> array) {
+  static void set(jobjectArray array) {
     (void)array;
   }
 };
 
-template <typename... Args>
-local_ref<JArrayClass<jobject>> makeArgsArray(Args... args) {
-  auto arr = JArrayClass<jobject>::newArray(sizeof...(args));
-  ArgsArraySetter<0, Args...>::set(arr, args...);
-  return arr;
-}
+// An Object[] from the pool, for the duration of one call.
+class PooledArgsArray {
+ public:
+  explicit PooledArgsArray(size_t length)
+      : array_(obtainArgsArray(length)), length_(length) {}
+  ~PooledArgsArray() {
+    recycleArgsArray(array_, length_);
+  }
 
-} // namespace
+  PooledArgsArray(const PooledArgsArray&) = delete;
+  PooledArgsArray& operator=(const PooledArgsArray&) = delete;
+
+  jobjectArray get() const {
+    return array_;
+  }
+
+ private:
+  jobjectArray array_;
+  size_t length_;
+};
+
+} // namespace detail
 
 template <typename... Args>
 inline void JMethod<void(Args...)>::operator()(
     alias_ref<jobject> self,
     Args... args) const {
   const auto env = Environment::current();
+  call(env, self, args...);
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
+}
+
+template <typename... Args>
+inline void JMethod<void(Args...)>::unchecked(
+    const UncheckedScope&,
+    alias_ref<jobject> self,
+    Args... args) const {
+  call(Environment::current(), self, args...);
+}
+
+template <typename... Args>
+inline void JMethod<void(Args...)>::call(
+    JNIEnv* env,
+    alias_ref<jobject> self,
+    Args... args) const {
   env->CallVoidMethod(
       self.get(),
       getId(),
       detail::callToJni(
           detail::Convert<typename std::decay<Args>::type>::toCall(args))...);
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
 }
 
 #pragma push_macro("DEFINE_PRIMITIVE_CALL")
@@ -95,14 +137,27 @@ inline void JMethod<void(Args...)>::operator()(
   inline TYPE JMethod<TYPE(Args...)>::operator()(                     \
       alias_ref<jobject> self, Args... args) const {                  \
     const auto env = Environment::current();                          \
-    auto result = env->Call##METHOD##Method(                          \
+    auto result = call(env, self, args...);                           \
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);                        \
+    return result;                                                    \
+  }                                                                   \
+                                                                      \
+  template <typename... Args>                                         \
+  inline TYPE JMethod<TYPE(Args...)>::unchecked(                      \
+      const UncheckedScope&, alias_ref<jobject> self, Args... args)   \
+      const {                                                         \
+    return call(Environment::current(), self, args...);               \
+  }                                                                   \
+                                                                      \
+  template <typename... Args>                                         \
+  inline TYPE JMethod<TYPE(Args...)>::call(                           \
+      JNIEnv* env, alias_ref<jobject> self, Args... args) const {     \
+    return env->Call##METHOD##Method(                                 \
         self.get(),                                                   \
         getId(),                                                      \
         detail::callToJni(                                            \
             detail::Convert<typename std::decay<Args>::type>::toCall( \
                 args))...);                                           \
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();                           \
-    return result;                                                    \
   }
 
 DEFINE_PRIMITIVE_CALL(jboolean, Boolean)
@@ -134,7 +189,18 @@ class JMethod<R(Args...)> : public JMethodBase {
   /// Invoke a method and return a local reference wrapping the result
   local_ref<JniRet> operator()(alias_ref<jobject> self, Args... args) const;
 
+  /// Like operator(), with the exception check left to scope. The result is
+  /// null if the method threw.
+  local_ref<JniRet> unchecked(
+      const UncheckedScope& scope,
+      alias_ref<jobject> self,
+      Args... args) const;
+
   friend class JClass;
+
+ private:
+  local_ref<JniRet> call(JNIEnv* env, alias_ref<jobject> self, Args... args)
+      const;
 };
 
 template <typename R, typename... Args>
@@ -142,12 +208,29 @@ inline auto JMethod<R(Args...)>::operator()(
     alias_ref<jobject> self,
     Args... args) const -> local_ref<JniRet> {
   const auto env = Environment::current();
+  auto result = call(env, self, args...);
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
+  return result;
+}
+
+template <typename R, typename... Args>
+inline auto JMethod<R(Args...)>::unchecked(
+    const UncheckedScope&,
+    alias_ref<jobject> self,
+    Args... args) const -> local_ref<JniRet> {
+  return call(Environment::current(), self, args...);
+}
+
+template <typename R, typename... Args>
+inline auto JMethod<R(Args...)>::call(
+    JNIEnv* env,
+    alias_ref<jobject> self,
+    Args... args) const -> local_ref<JniRet> {
   auto result = env->CallObjectMethod(
       self.get(),
       getId(),
       detail::callToJni(
           detail::Convert<typename std::decay<Args>::type>::toCall(args))...);
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
   return adopt_local(static_cast<JniType<JniRet>>(result));
 }
 
@@ -156,12 +239,28 @@ inline void JStaticMethod<void(Args...)>::operator()(
     alias_ref<jclass> cls,
     Args... args) const {
   const auto env = Environment::current();
+  call(env, cls, args...);
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
+}
+
+template <typename... Args>
+inline void JStaticMethod<void(Args...)>::unchecked(
+    const UncheckedScope&,
+    alias_ref<jclass> cls,
+    Args... args) const {
+  call(Environment::current(), cls, args...);
+}
+
+template <typename... Args>
+inline void JStaticMethod<void(Args...)>::call(
+    JNIEnv* env,
+    alias_ref<jclass> cls,
+    Args... args) const {
   env->CallStaticVoidMethod(
       cls.get(),
       getId(),
       detail::callToJni(
           detail::Convert<typename std::decay<Args>::type>::toCall(args))...);
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
 }
 
 #pragma push_macro("DEFINE_PRIMITIVE_STATIC_CALL")
@@ -171,14 +270,27 @@ inline void JStaticMethod<void(Args...)>::operator()(
   inline TYPE JStaticMethod<TYPE(Args...)>::operator()(               \
       alias_ref<jclass> cls, Args... args) const {                    \
     const auto env = Environment::current();                          \
-    auto result = env->CallStatic##METHOD##Method(                    \
+    auto result = call(env, cls, args...);                            \
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);                        \
+    return result;                                                    \
+  }                                                                   \
+                                                                      \
+  template <typename... Args>                                         \
+  inline TYPE JStaticMethod<TYPE(Args...)>::unchecked(                \
+      const UncheckedScope&, alias_ref<jclass> cls, Args... args)     \
+      const {                                                         \
+    return call(Environment::current(), cls, args...);                \
+  }                                                                   \
+                                                                      \
+  template <typename... Args>                                         \
+  inline TYPE JStaticMethod<TYPE(Args...)>::call(                     \
+      JNIEnv* env, alias_ref<jclass> cls, Args... args) const {       \
+    return env->CallStatic##METHOD##Method(                           \
         cls.get(),                                                    \
         getId(),                                                      \
         detail::callToJni(                                            \
             detail::Convert<typename std::decay<Args>::type>::toCall( \
                 args))...);                                           \
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();                           \
-    return result;                                                    \
   }
 
 DEFINE_PRIMITIVE_STATIC_CALL(jboolean, Boolean)
@@ -208,16 +320,32 @@ class JStaticMethod<R(Args...)> : public JMethodBase {
   /// Invoke a method and return a local reference wrapping the result
   local_ref<JniRet> operator()(alias_ref<jclass> cls, Args... args) const {
     const auto env = Environment::current();
+    auto result = call(env, cls, args...);
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
+    return result;
+  }
+
+  /// Like operator(), with the exception check left to scope. The result is
+  /// null if the method threw.
+  local_ref<JniRet> unchecked(
+      const UncheckedScope&,
+      alias_ref<jclass> cls,
+      Args... args) const {
+    return call(Environment::current(), cls, args...);
+  }
+
+  friend class JClass;
+
+ private:
+  local_ref<JniRet>
+  call(JNIEnv* env, alias_ref<jclass> cls, Args... args) const {
     auto result = env->CallStaticObjectMethod(
         cls.get(),
         getId(),
         detail::callToJni(
             detail::Convert<typename std::decay<Args>::type>::toCall(args))...);
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
     return adopt_local(static_cast<JniType<JniRet>>(result));
   }
-
-  friend class JClass;
 };
 
 template <typename... Args>
@@ -232,7 +360,7 @@ inline void JNonvirtualMethod<void(Args...)>::operator()(
       getId(),
       detail::callToJni(
           detail::Convert<typename std::decay<Args>::type>::toCall(args))...);
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
 }
 
 #pragma push_macro("DEFINE_PRIMITIVE_NON_VIRTUAL_CALL")
@@ -249,7 +377,7 @@ inline void JNonvirtualMethod<void(Args...)>::operator()(
         detail::callToJni(                                                  \
             detail::Convert<typename std::decay<Args>::type>::toCall(       \
                 args))...);                                                 \
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();                                 \
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);                              \
     return result;                                                          \
   }
 
@@ -289,7 +417,7 @@ class JNonvirtualMethod<R(Args...)> : public JMethodBase {
         getId(),
         detail::callToJni(
             detail::Convert<typename std::decay<Args>::type>::toCall(args))...);
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
     return adopt_local(static_cast<JniType<JniRet>>(result));
   }
 
@@ -303,17 +431,15 @@ slowCall(jmethodID method_id, alias_ref<jobject> self, Args... args) {
       findClassStatic("java/lang/reflect/Method")
           ->getMethod<jobject(jobject, JArrayClass<jobject>::javaobject)>(
               "invoke");
-  // TODO(xxxxxxx): Provide fbjni interface to ToReflectedMethod.
-  auto reflected = adopt_local(Environment::current()->ToReflectedMethod(
-      self->getClass().get(), method_id, JNI_FALSE));
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
-  if (!reflected)
-    throw std::runtime_error(
-        "Unable to get reflected java.lang.reflect.Method");
-  auto argsArray = makeArgsArray(args...);
+  auto reflected = detail::reflectedMethod(self.get(), method_id);
+  detail::PooledArgsArray argsArray(sizeof...(args));
+  detail::ArgsArraySetter<0, Args...>::set(argsArray.get(), args...);
   // No need to check for exceptions since invoke is itself a JMethod that will
   // do that for us.
-  return invoke(reflected, self.get(), argsArray.get());
+  return invoke(
+      reflected,
+      self.get(),
+      static_cast<JArrayClass<jobject>::javaobject>(argsArray.get()));
 }
 
 // JField<T>
@@ -22,6 +22,10 @@
 #include "Meta.h"
 // clang-format on
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace facebook {
 namespace jni {
 
@@ -47,5 +51,87 @@ DEFINE_CONSTANTS_FOR_FIELD_AND_ARRAY_TRAIT(jlong, J)
 DEFINE_CONSTANTS_FOR_FIELD_AND_ARRAY_TRAIT(jfloat, F)
 DEFINE_CONSTANTS_FOR_FIELD_AND_ARRAY_TRAIT(jdouble, D)
 
+namespace detail {
+
+namespace {
+
+// Idle argument arrays kept per length. Calls that overlap, on one thread or
+// several, each need an array of their own; a few covers the common case.
+constexpr size_t kMaxIdleArgsArrays = 4;
+
+// Both caches hold global references for the life of the process, and are
+// never destroyed, so exit doesn't have to delete references without a JVM.
+std::mutex reflectedMethodsMutex;
+auto& reflectedMethods = *new std::unordered_map<jmethodID, jobject>();
+
+std::mutex idleArgsArraysMutex;
+auto& idleArgsArrays =
+    *new std::unordered_map<size_t, std::vector<jobjectArray>>();
+
+} // namespace
+
+jobject reflectedMethod(jobject self, jmethodID method_id) {
+  {
+    std::lock_guard<std::mutex> lock(reflectedMethodsMutex);
+    auto it = reflectedMethods.find(method_id);
+    if (it != reflectedMethods.end()) {
+      return it->second;
+    }
+  }
+
+  const auto env = Environment::current();
+  auto cls = adopt_local(env->GetObjectClass(self));
+  auto reflected = adopt_local(
+      env->ToReflectedMethod(cls.get(), method_id, JNI_FALSE));
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
+  if (!reflected) {
+    throw std::runtime_error(
+        "Unable to get reflected java.lang.reflect.Method");
+  }
+
+  auto global = make_global(reflected);
+  std::lock_guard<std::mutex> lock(reflectedMethodsMutex);
+  // Another thread may have got here first, in which case ours is dropped.
+  auto result = reflectedMethods.emplace(method_id, global.get());
+  if (result.second) {
+    global.release();
+  }
+  return result.first->second;
+}
+
+jobjectArray obtainArgsArray(size_t length) {
+  {
+    std::lock_guard<std::mutex> lock(idleArgsArraysMutex);
+    auto& idle = idleArgsArrays[length];
+    if (!idle.empty()) {
+      auto array = idle.back();
+      idle.pop_back();
+      return array;
+    }
+  }
+  auto array = JArrayClass<jobject>::newArray(length);
+  return static_cast<jobjectArray>(make_global(array).release());
+}
+
+void recycleArgsArray(jobjectArray array, size_t length) noexcept {
+  const auto env = Environment::current();
+  // Clearing the array needs JNI calls, which can't be made while an
+  // exception is pending; such an array is just freed.
+  if (!env->ExceptionCheck()) {
+    for (size_t i = 0; i < length; ++i) {
+      env->SetObjectArrayElement(array, static_cast<jsize>(i), nullptr);
+    }
+    std::lock_guard<std::mutex> lock(idleArgsArraysMutex);
+    auto& idle = idleArgsArrays[length];
+    if (idle.size() < kMaxIdleArgsArrays) {
+      idle.push_back(array);
+      return;
+    }
+  }
+  adopt_global(static_cast<JArrayClass<jobject>::javaobject>(array));
+}
+
+} // namespace detail
+
 } // namespace jni
 } // namespace facebook
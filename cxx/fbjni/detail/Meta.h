@@ -50,11 +50,29 @@ namespace jni {
 // This will get the reflected Java Method from the method_id, get it's invoke
 // method, and call the method via that. This shouldn't ever be needed, but
 // Android 6.0 crashes when calling a method on a java.lang.Proxy via jni.
+// The reflected Method is looked up once per method_id, and the arguments go
+// in an Object[] borrowed from a pool, so repeated calls only pay for the
+// invoke itself and for boxing primitive arguments.
 template <typename... Args>
 local_ref<jobject>
 slowCall(jmethodID method_id, alias_ref<jobject> self, Args... args);
 
+namespace detail {
+
+// The java.lang.reflect.Method for method_id, an instance method of self's
+// class. The reference is global and owned by a cache that lives as long as
+// the process.
+FBJNI_API jobject reflectedMethod(jobject self, jmethodID method_id);
+
+// Borrows an Object[] of the given length, as a global reference, and gives
+// it back. Returned arrays are cleared so they don't keep arguments alive.
+FBJNI_API jobjectArray obtainArgsArray(size_t length);
+FBJNI_API void recycleArgsArray(jobjectArray array, size_t length) noexcept;
+
+} // namespace detail
+
 class JObject;
+class UncheckedScope;
 
 /// Wrapper of a jmethodID. Provides a common base for JMethod specializations
 class JMethodBase {
@@ -98,7 +116,17 @@ class JMethod;
                                                                   \
     TYPE operator()(alias_ref<jobject> self, Args... args) const; \
                                                                   \
+    /* Like operator(), with the exception check left to scope */ \
+    TYPE unchecked(                                               \
+        const UncheckedScope& scope,                              \
+        alias_ref<jobject> self,                                  \
+        Args... args) const;                                      \
+                                                                  \
     friend class JClass;                                          \
+                                                                  \
+   private:                                                       \
+    TYPE call(JNIEnv* env, alias_ref<jobject> self, Args... args) \
+        const;                                                    \
   };
 
 DEFINE_PRIMITIVE_METHOD_CLASS(void)
@@ -150,7 +178,16 @@ class JStaticMethod;
                                                                              \
     TYPE operator()(alias_ref<jclass> cls, Args... args) const;              \
                                                                              \
+    /* Like operator(), with the exception check left to scope */            \
+    TYPE unchecked(                                                          \
+        const UncheckedScope& scope,                                         \
+        alias_ref<jclass> cls,                                               \
+        Args... args) const;                                                 \
+                                                                             \
     friend class JClass;                                                     \
+                                                                             \
+   private:                                                                  \
+    TYPE call(JNIEnv* env, alias_ref<jclass> cls, Args... args) const;       \
   };
 
 DEFINE_PRIMITIVE_STATIC_METHOD_CLASS(void)
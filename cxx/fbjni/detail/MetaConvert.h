@@ -162,6 +162,25 @@ struct Convert<global_ref<T>> {
   }
 };
 
+// convert return from shared_global_ref<T>
+template <typename T>
+struct Convert<shared_global_ref<T>> {
+  typedef JniType<T> jniType;
+  // No automatic synthesis of shared_global_ref
+  static jniType toJniRet(shared_global_ref<jniType>&& t) {
+    // As for global_ref, this may be the last share, so the reference is only
+    // safe to return to java as a local.
+    auto ret = make_local(t);
+    return ret.release();
+  }
+  static jniType toJniRet(const shared_global_ref<jniType>& t) {
+    return t.get();
+  }
+  static jniType toCall(const shared_global_ref<jniType>& t) {
+    return t.get();
+  }
+};
+
 template <typename T>
 struct jni_sig_from_cxx_t;
 template <typename R, typename... Args>
@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ReferenceAccounting.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define FBJNI_RETURN_ADDRESS() _ReturnAddress()
+#define FBJNI_NOINLINE __declspec(noinline)
+#else
+#define FBJNI_RETURN_ADDRESS() __builtin_return_address(0)
+#define FBJNI_NOINLINE __attribute__((noinline))
+#endif
+
+namespace facebook {
+namespace jni {
+
+namespace internal {
+std::atomic<bool> g_reference_accounting_enabled{false};
+} // namespace internal
+
+namespace {
+
+void raiseHighWater(std::atomic<std::int64_t>& highWater, std::int64_t value) {
+  auto current = highWater.load(std::memory_order_relaxed);
+  while (value > current &&
+         !highWater.compare_exchange_weak(
+             current, value, std::memory_order_relaxed)) {
+  }
+}
+
+// Local counts are only written by their own thread, so they don't need
+// read-modify-write operations; they are atomic so that snapshot() can read
+// them.
+void addTo(std::atomic<std::int64_t>& counter, std::int64_t delta) {
+  counter.store(
+      counter.load(std::memory_order_relaxed) + delta,
+      std::memory_order_relaxed);
+}
+
+struct ThreadShard {
+  std::thread::id threadId{std::this_thread::get_id()};
+  std::atomic<std::int64_t> liveLocals{0};
+  std::atomic<std::int64_t> localsHighWater{0};
+
+  // Only touched by the owning thread. Frame references below frameBase were
+  // created before accounting was last enabled, so they aren't counted.
+  std::size_t frameLocals{0};
+  std::size_t frameBase{0};
+  std::uint64_t generation{0};
+  bool warned{false};
+  bool inWarning{false};
+};
+
+struct SiteKey {
+  const void* site;
+  jobjectRefType type;
+
+  bool operator==(const SiteKey& other) const {
+    return site == other.site && type == other.type;
+  }
+};
+
+struct SiteKeyHash {
+  std::size_t operator()(const SiteKey& key) const {
+    return std::hash<const void*>()(key.site) ^
+        static_cast<std::size_t>(key.type);
+  }
+};
+
+struct OwnerKey {
+  const ThreadShard* shard; // null for global and weak references
+  jobject reference;
+
+  bool operator==(const OwnerKey& other) const {
+    return shard == other.shard && reference == other.reference;
+  }
+};
+
+struct OwnerKeyHash {
+  std::size_t operator()(const OwnerKey& key) const {
+    return std::hash<const void*>()(key.shard) ^
+        std::hash<const void*>()(key.reference);
+  }
+};
+
+struct SiteStats {
+  std::int64_t live{0};
+  std::int64_t highWater{0};
+  std::uint64_t created{0};
+};
+
+struct Accounting {
+  std::mutex mutex;
+  // Bumped by every enable(), so that threads notice their counts were reset.
+  std::atomic<std::uint64_t> generation{0};
+  std::unordered_set<ThreadShard*> shards;
+  std::int64_t exitedLocalsHighWater{0};
+
+  std::atomic<std::int64_t> liveGlobals{0};
+  std::atomic<std::int64_t> globalsHighWater{0};
+  std::atomic<std::int64_t> liveWeaks{0};
+  std::atomic<std::int64_t> weaksHighWater{0};
+
+  std::atomic<std::size_t> warningThreshold{0};
+  std::function<void(const ThreadReferenceStats&)> onWarning;
+
+  std::atomic<bool> attributeCallSites{false};
+  std::mutex siteMutex;
+  std::unordered_map<SiteKey, SiteStats, SiteKeyHash> sites;
+  std::unordered_map<OwnerKey, SiteKey, OwnerKeyHash> owners;
+  // Sites of frame references, in creation order, per thread.
+  std::unordered_map<const ThreadShard*, std::vector<SiteKey>> frameSites;
+};
+
+// Leaked, so that threads exiting during static destruction can still use it.
+Accounting& accounting() {
+  static auto* instance = new Accounting;
+  return *instance;
+}
+
+struct ShardHolder {
+  ThreadShard* shard{nullptr};
+
+  ~ShardHolder();
+};
+
+thread_local ShardHolder tlsShard;
+// Set once the ShardHolder is destroyed, after which it can't be used again.
+thread_local bool tlsShardDestroyed = false;
+
+ShardHolder::~ShardHolder() {
+  tlsShardDestroyed = true;
+  if (!shard) {
+    return;
+  }
+  auto& acc = accounting();
+  {
+    // A later thread may get a shard at the same address.
+    std::lock_guard<std::mutex> lock(acc.siteMutex);
+    acc.frameSites.erase(shard);
+    for (auto it = acc.owners.begin(); it != acc.owners.end();) {
+      it = it->first.shard == shard ? acc.owners.erase(it) : std::next(it);
+    }
+  }
+  std::lock_guard<std::mutex> lock(acc.mutex);
+  acc.exitedLocalsHighWater = std::max(
+      acc.exitedLocalsHighWater, shard->localsHighWater.load());
+  acc.shards.erase(shard);
+  delete shard;
+}
+
+ThreadShard* currentShard() {
+  if (tlsShard.shard || tlsShardDestroyed) {
+    return tlsShard.shard;
+  }
+  auto shard = new ThreadShard;
+  auto& acc = accounting();
+  {
+    std::lock_guard<std::mutex> lock(acc.mutex);
+    acc.shards.insert(shard);
+  }
+  tlsShard.shard = shard;
+  return shard;
+}
+
+// Called by the owning thread before it uses its frame counts.
+void syncGeneration(ThreadShard& shard) {
+  auto generation = accounting().generation.load(std::memory_order_acquire);
+  if (shard.generation != generation) {
+    shard.generation = generation;
+    shard.frameBase = shard.frameLocals;
+  }
+}
+
+ThreadReferenceStats statsOf(const ThreadShard& shard) {
+  return {
+      shard.threadId,
+      shard.liveLocals.load(std::memory_order_relaxed),
+      shard.localsHighWater.load(std::memory_order_relaxed)};
+}
+
+void warnIfNeeded(ThreadShard& shard, std::int64_t live) {
+  auto& acc = accounting();
+  auto threshold = static_cast<std::int64_t>(
+      acc.warningThreshold.load(std::memory_order_relaxed));
+  if (threshold == 0) {
+    return;
+  }
+  if (shard.warned) {
+    // Re-arm once the thread is comfortably below the threshold again.
+    if (live < threshold - threshold / 4) {
+      shard.warned = false;
+    }
+    return;
+  }
+  if (live < threshold || shard.inWarning) {
+    return;
+  }
+  shard.warned = true;
+  std::function<void(const ThreadReferenceStats&)> onWarning;
+  {
+    std::lock_guard<std::mutex> lock(acc.mutex);
+    onWarning = acc.onWarning;
+  }
+  if (onWarning) {
+    // The callback may well create references of its own.
+    shard.inWarning = true;
+    try {
+      onWarning(statsOf(shard));
+    } catch (...) {
+    }
+    shard.inWarning = false;
+  }
+}
+
+void siteAdded(
+    const ThreadShard* shard,
+    jobjectRefType type,
+    jobject reference,
+    bool inFrame,
+    const void* site) {
+  auto& acc = accounting();
+  SiteKey key{site, type};
+  std::lock_guard<std::mutex> lock(acc.siteMutex);
+  auto& stats = acc.sites[key];
+  ++stats.created;
+  stats.highWater = std::max(stats.highWater, ++stats.live);
+  if (inFrame) {
+    acc.frameSites[shard].push_back(key);
+  } else {
+    acc.owners[{type == JNILocalRefType ? shard : nullptr, reference}] = key;
+  }
+}
+
+void siteRemoved(
+    const ThreadShard* shard,
+    jobjectRefType type,
+    jobject reference) {
+  auto& acc = accounting();
+  std::lock_guard<std::mutex> lock(acc.siteMutex);
+  auto owner =
+      acc.owners.find({type == JNILocalRefType ? shard : nullptr, reference});
+  if (owner == acc.owners.end()) {
+    // Created before call sites were attributed.
+    return;
+  }
+  --acc.sites[owner->second].live;
+  acc.owners.erase(owner);
+}
+
+void framePoppedSites(const ThreadShard* shard, std::size_t mark) {
+  auto& acc = accounting();
+  std::lock_guard<std::mutex> lock(acc.siteMutex);
+  auto frame = acc.frameSites.find(shard);
+  if (frame == acc.frameSites.end() || frame->second.size() <= mark) {
+    return;
+  }
+  for (auto i = mark; i < frame->second.size(); ++i) {
+    --acc.sites[frame->second[i]].live;
+  }
+  frame->second.resize(mark);
+}
+
+void addGlobal(
+    std::atomic<std::int64_t>& live,
+    std::atomic<std::int64_t>& highWater,
+    std::int64_t delta) {
+  // Global references go through the VM's global reference table lock anyway,
+  // so sharing these counters between threads costs little.
+  auto value = live.fetch_add(delta, std::memory_order_relaxed) + delta;
+  if (delta > 0) {
+    raiseHighWater(highWater, value);
+  }
+}
+
+void account(
+    jobjectRefType type,
+    jobject reference,
+    bool inFrame,
+    std::int64_t delta,
+    const void* site) {
+  auto& acc = accounting();
+  auto shard = currentShard();
+  switch (type) {
+    case JNILocalRefType:
+      if (!shard) {
+        return;
+      }
+      addTo(shard->liveLocals, delta);
+      if (delta > 0) {
+        if (inFrame) {
+          syncGeneration(*shard);
+          ++shard->frameLocals;
+        }
+        auto live = shard->liveLocals.load(std::memory_order_relaxed);
+        if (live > shard->localsHighWater.load(std::memory_order_relaxed)) {
+          shard->localsHighWater.store(live, std::memory_order_relaxed);
+        }
+        warnIfNeeded(*shard, live);
+      } else if (shard->warned) {
+        warnIfNeeded(*shard, shard->liveLocals.load(std::memory_order_relaxed));
+      }
+      break;
+    case JNIGlobalRefType:
+      addGlobal(acc.liveGlobals, acc.globalsHighWater, delta);
+      break;
+    case JNIWeakGlobalRefType:
+      addGlobal(acc.liveWeaks, acc.weaksHighWater, delta);
+      break;
+    default:
+      return;
+  }
+
+  if (acc.attributeCallSites.load(std::memory_order_relaxed)) {
+    if (delta > 0) {
+      siteAdded(shard, type, reference, inFrame, site);
+    } else {
+      siteRemoved(shard, type, reference);
+    }
+  }
+}
+
+} // namespace
+
+namespace internal {
+
+FBJNI_NOINLINE void accountReferenceAdded(
+    jobjectRefType type,
+    jobject reference,
+    bool inFrame) noexcept {
+  // Called from code inlined into the function creating the reference, so the
+  // return address is in that function.
+  account(type, reference, inFrame, 1, FBJNI_RETURN_ADDRESS());
+}
+
+void accountReferenceRemoved(
+    jobjectRefType type,
+    jobject reference) noexcept {
+  account(type, reference, false, -1, nullptr);
+}
+
+std::size_t accountFramePushed() noexcept {
+  auto shard = currentShard();
+  return shard ? shard->frameLocals : 0;
+}
+
+void accountFramePopped(std::size_t mark) noexcept {
+  auto shard = currentShard();
+  if (!shard || shard->frameLocals < mark) {
+    return;
+  }
+  syncGeneration(*shard);
+  // The frame may have been pushed before accounting was re-enabled.
+  auto counted = std::max(mark, shard->frameBase);
+  addTo(
+      shard->liveLocals,
+      -static_cast<std::int64_t>(shard->frameLocals - counted));
+  if (accounting().attributeCallSites.load(std::memory_order_relaxed)) {
+    framePoppedSites(shard, counted - shard->frameBase);
+  }
+  shard->frameLocals = mark;
+  shard->frameBase = std::min(shard->frameBase, mark);
+}
+
+} // namespace internal
+
+/* static */
+void ReferenceAccounting::enable(ReferenceAccountingOptions options) {
+  auto& acc = accounting();
+  {
+    std::lock_guard<std::mutex> lock(acc.mutex);
+    for (auto shard : acc.shards) {
+      shard->liveLocals = 0;
+      shard->localsHighWater = 0;
+    }
+    acc.exitedLocalsHighWater = 0;
+    acc.liveGlobals = 0;
+    acc.globalsHighWater = 0;
+    acc.liveWeaks = 0;
+    acc.weaksHighWater = 0;
+    acc.warningThreshold = options.localReferenceWarningThreshold;
+    acc.onWarning = std::move(options.onLocalReferenceWarning);
+    ++acc.generation;
+  }
+  {
+    std::lock_guard<std::mutex> lock(acc.siteMutex);
+    acc.sites.clear();
+    acc.owners.clear();
+    acc.frameSites.clear();
+  }
+  acc.attributeCallSites = options.attributeCallSites;
+  internal::g_reference_accounting_enabled = true;
+}
+
+/* static */
+void ReferenceAccounting::enable() {
+  enable(ReferenceAccountingOptions());
+}
+
+/* static */
+void ReferenceAccounting::disable() {
+  internal::g_reference_accounting_enabled = false;
+  auto& acc = accounting();
+  std::lock_guard<std::mutex> lock(acc.mutex);
+  acc.warningThreshold = 0;
+  acc.onWarning = nullptr;
+}
+
+/* static */
+bool ReferenceAccounting::isEnabled() {
+  return internal::isReferenceAccountingEnabled();
+}
+
+/* static */
+ReferenceAccountingSnapshot ReferenceAccounting::snapshot() {
+  auto& acc = accounting();
+  ReferenceAccountingSnapshot snapshot{};
+  {
+    std::lock_guard<std::mutex> lock(acc.mutex);
+    snapshot.localsHighWater = acc.exitedLocalsHighWater;
+    for (auto shard : acc.shards) {
+      auto stats = statsOf(*shard);
+      snapshot.liveLocals += stats.liveLocals;
+      snapshot.localsHighWater =
+          std::max(snapshot.localsHighWater, stats.localsHighWater);
+      snapshot.threads.push_back(stats);
+    }
+  }
+  snapshot.liveGlobals = acc.liveGlobals.load();
+  snapshot.globalsHighWater = acc.globalsHighWater.load();
+  snapshot.liveWeakGlobals = acc.liveWeaks.load();
+  snapshot.weakGlobalsHighWater = acc.weaksHighWater.load();
+  {
+    std::lock_guard<std::mutex> lock(acc.siteMutex);
+    for (const auto& site : acc.sites) {
+      snapshot.callSites.push_back(
+          {site.first.site,
+           site.first.type,
+           site.second.live,
+           site.second.highWater,
+           site.second.created});
+    }
+  }
+  return snapshot;
+}
+
+/* static */
+void ReferenceAccounting::resetHighWaterMarks() {
+  auto& acc = accounting();
+  {
+    std::lock_guard<std::mutex> lock(acc.mutex);
+    for (auto shard : acc.shards) {
+      shard->localsHighWater = shard->liveLocals.load();
+    }
+    acc.exitedLocalsHighWater = 0;
+    acc.globalsHighWater = acc.liveGlobals.load();
+    acc.weaksHighWater = acc.liveWeaks.load();
+  }
+  std::lock_guard<std::mutex> lock(acc.siteMutex);
+  for (auto& site : acc.sites) {
+    site.second.highWater = site.second.live;
+  }
+}
+
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ReferenceAccounting.h
+ *
+ * Accounting of the JNI references owned by fbjni smart references, cheap
+ * enough to leave enabled in production. It keeps per thread counts of live
+ * local references (the local reference table is per thread, and overflowing
+ * it aborts the process) and process wide counts of live global and weak global
+ * references (to catch leaks), with high water marks for each. Optionally the
+ * counts are also attributed to the call site that created the references.
+ *
+ * Only references owned by local_ref, frame_local_ref, global_ref, weak_ref and
+ * shared_global_ref are counted. References that are returned to Java are no
+ * longer counted once they are released.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <jni.h>
+
+#include <fbjni/detail/FbjniApi.h>
+
+namespace facebook {
+namespace jni {
+
+/// Local references owned by one thread
+struct ThreadReferenceStats {
+  std::thread::id threadId;
+  std::int64_t liveLocals;
+  std::int64_t localsHighWater;
+};
+
+/// References created at one call site (only collected when call sites are
+/// attributed). The site is a code address in the function that created the
+/// references; resolve it with dladdr or addr2line. It is only precise in
+/// optimized builds, where fbjni's reference code is inlined into its caller.
+struct CallSiteReferenceStats {
+  const void* site;
+  jobjectRefType type;
+  std::int64_t live;
+  std::int64_t highWater;
+  std::uint64_t created;
+};
+
+struct ReferenceAccountingSnapshot {
+  /// Live local references, summed over all threads
+  std::int64_t liveLocals;
+  std::int64_t liveGlobals;
+  std::int64_t liveWeakGlobals;
+  /// Highest live local count of any single thread, including exited ones
+  std::int64_t localsHighWater;
+  std::int64_t globalsHighWater;
+  std::int64_t weakGlobalsHighWater;
+  std::vector<ThreadReferenceStats> threads;
+  std::vector<CallSiteReferenceStats> callSites;
+};
+
+struct ReferenceAccountingOptions {
+  /// Also attribute references to the call site that created them. This takes
+  /// a lock for every reference created or deleted, so it is meant for
+  /// tracking down a problem rather than for leaving on.
+  bool attributeCallSites = false;
+
+  /// When a thread's live local references reach this count,
+  /// onLocalReferenceWarning is called on that thread. It is called again only
+  /// after the count has dropped well below the threshold. 0 disables it.
+  /// disable() drops the callback, but one already running on another thread
+  /// may still be finishing, so anything it captures must outlive that.
+  std::size_t localReferenceWarningThreshold = 0;
+  std::function<void(const ThreadReferenceStats&)> onLocalReferenceWarning;
+};
+
+struct ReferenceAccounting {
+  /// Starts counting from zero. References that exist when this is called
+  /// aren't known, so it should be enabled early (e.g. from the function passed
+  /// to initialize()).
+  static void enable(ReferenceAccountingOptions options);
+  static void enable();
+  static void disable();
+  static bool isEnabled();
+
+  static ReferenceAccountingSnapshot snapshot();
+
+  /// Lowers all high water marks to the current live counts
+  static void resetHighWaterMarks();
+};
+
+/// @cond INTERNAL
+namespace internal {
+
+extern FBJNI_API std::atomic<bool> g_reference_accounting_enabled;
+
+inline bool isReferenceAccountingEnabled() noexcept {
+  return g_reference_accounting_enabled.load(std::memory_order_relaxed);
+}
+
+// An owned reference took over a reference, either newly created or adopted.
+// References in a JniLocalScope's frame stay counted until the frame is popped.
+FBJNI_API void accountReferenceAdded(
+    jobjectRefType type,
+    jobject reference,
+    bool inFrame) noexcept;
+
+// An owned reference deleted or released a reference.
+FBJNI_API void accountReferenceRemoved(
+    jobjectRefType type,
+    jobject reference) noexcept;
+
+// Frame references created after the returned mark are uncounted when the
+// frame is popped.
+FBJNI_API std::size_t accountFramePushed() noexcept;
+FBJNI_API void accountFramePopped(std::size_t mark) noexcept;
+
+} // namespace internal
+/// @endcond
+
+} // namespace jni
+} // namespace facebook
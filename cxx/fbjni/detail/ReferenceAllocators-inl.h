@@ -22,6 +22,7 @@
 
 #include <fbjni/detail/FbjniApi.h>
 #include "Environment.h"
+#include "ReferenceAccounting.h"
 
 namespace facebook {
 namespace jni {
@@ -50,8 +51,9 @@ inline jobject LocalReferenceAllocator::newReference(jobject original) const {
 #ifdef FBJNI_DEBUG_REFS
   ++internal::g_reference_stats.locals_created;
 #endif
-  auto ref = Environment::current()->NewLocalRef(original);
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+  const auto env = Environment::current();
+  auto ref = env->NewLocalRef(original);
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
   return ref;
 }
 
@@ -73,6 +75,26 @@ inline bool LocalReferenceAllocator::verifyReference(
   return isObjectRefType(reference, JNILocalRefType);
 }
 
+// FrameLocalReferenceAllocator
+// ////////////////////////////////////////////////////////////////////
+
+inline jobject FrameLocalReferenceAllocator::newReference(
+    jobject original) const {
+  return LocalReferenceAllocator{}.newReference(original);
+}
+
+inline void FrameLocalReferenceAllocator::deleteReference(
+    jobject reference) const noexcept {
+  // Nothing to verify: the frame, and the reference with it, may already have
+  // been popped, which is how a frame_local_ref is meant to be used.
+  internal::dbglog("Frame local release (deferred): %p", reference);
+}
+
+inline bool FrameLocalReferenceAllocator::verifyReference(
+    jobject reference) const noexcept {
+  return isObjectRefType(reference, JNILocalRefType);
+}
+
 // GlobalReferenceAllocator
 // ////////////////////////////////////////////////////////////////////////
 
@@ -81,8 +103,9 @@ inline jobject GlobalReferenceAllocator::newReference(jobject original) const {
 #ifdef FBJNI_DEBUG_REFS
   ++internal::g_reference_stats.globals_created;
 #endif
-  auto ref = Environment::current()->NewGlobalRef(original);
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+  const auto env = Environment::current();
+  auto ref = env->NewGlobalRef(original);
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
   return ref;
 }
 
@@ -113,8 +136,9 @@ inline jobject WeakGlobalReferenceAllocator::newReference(
 #ifdef FBJNI_DEBUG_REFS
   ++internal::g_reference_stats.weaks_created;
 #endif
-  auto ref = Environment::current()->NewWeakGlobalRef(original);
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+  const auto env = Environment::current();
+  auto ref = env->NewWeakGlobalRef(original);
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
   return ref;
 }
 
@@ -136,5 +160,59 @@ inline bool WeakGlobalReferenceAllocator::verifyReference(
   return isObjectRefType(reference, JNIWeakGlobalRefType);
 }
 
+/// @cond INTERNAL
+namespace internal {
+
+// Called by owned references when they take over a reference (adopting it or
+// creating it) and when they let go of one (deleting or releasing it). The
+// allocator determines what kind of reference it is. References handled by
+// other allocators aren't accounted for.
+template <typename Alloc>
+struct ReferenceAccountingHooks {
+  static void adopted(jobject) noexcept {}
+  static void dropped(jobject) noexcept {}
+};
+
+template <jobjectRefType kType>
+struct OwnedReferenceAccountingHooks {
+  static void adopted(jobject reference) noexcept {
+    if (isReferenceAccountingEnabled()) {
+      accountReferenceAdded(kType, reference, false);
+    }
+  }
+  static void dropped(jobject reference) noexcept {
+    if (isReferenceAccountingEnabled()) {
+      accountReferenceRemoved(kType, reference);
+    }
+  }
+};
+
+template <>
+struct ReferenceAccountingHooks<LocalReferenceAllocator>
+    : OwnedReferenceAccountingHooks<JNILocalRefType> {};
+
+template <>
+struct ReferenceAccountingHooks<GlobalReferenceAllocator>
+    : OwnedReferenceAccountingHooks<JNIGlobalRefType> {};
+
+template <>
+struct ReferenceAccountingHooks<WeakGlobalReferenceAllocator>
+    : OwnedReferenceAccountingHooks<JNIWeakGlobalRefType> {};
+
+// Frame references keep their slot in the local reference table until the
+// frame is popped, whatever happens to the owning reference.
+template <>
+struct ReferenceAccountingHooks<FrameLocalReferenceAllocator> {
+  static void adopted(jobject reference) noexcept {
+    if (isReferenceAccountingEnabled()) {
+      accountReferenceAdded(JNILocalRefType, reference, true);
+    }
+  }
+  static void dropped(jobject) noexcept {}
+};
+
+} // namespace internal
+/// @endcond
+
 } // namespace jni
 } // namespace facebook
@@ -36,6 +36,18 @@ class LocalReferenceAllocator {
   bool verifyReference(jobject reference) const noexcept;
 };
 
+/**
+ * Allocator that handles local references created inside a JniLocalScope. The
+ * references are only reclaimed when the scope pops its frame, so deleting
+ * them is a no-op.
+ */
+class FrameLocalReferenceAllocator {
+ public:
+  jobject newReference(jobject original) const;
+  void deleteReference(jobject reference) const noexcept;
+  bool verifyReference(jobject reference) const noexcept;
+};
+
 /// Allocator that handles global references
 class GlobalReferenceAllocator {
  public:
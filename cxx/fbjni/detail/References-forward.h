@@ -66,10 +66,19 @@ class weak_ref;
 template <typename T>
 class alias_ref;
 
+template <typename T>
+class shared_global_ref;
+
 /// A smart unique reference owning a local JNI reference
 template <typename T>
 using local_ref = basic_strong_ref<T, LocalReferenceAllocator>;
 
+/// A smart unique reference to a local JNI reference owned by the enclosing
+/// JniLocalScope. Destroying it doesn't delete the reference; popping the
+/// scope's frame does.
+template <typename T>
+using frame_local_ref = basic_strong_ref<T, FrameLocalReferenceAllocator>;
+
 /// A smart unique reference owning a global JNI reference
 template <typename T>
 using global_ref = basic_strong_ref<T, GlobalReferenceAllocator>;
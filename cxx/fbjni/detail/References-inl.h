@@ -37,6 +37,11 @@ inline JniType<T> getPlainJniReference(const base_owned_ref<T, A>& ref) {
   return ref.get();
 }
 
+template <typename T>
+inline JniType<T> getPlainJniReference(const shared_global_ref<T>& ref) {
+  return ref.get();
+}
+
 namespace detail {
 template <typename Repr>
 struct ReprAccess {
@@ -171,6 +176,14 @@ make_weak(const T& ref) {
       detail::make_ref<T, WeakGlobalReferenceAllocator>(ref));
 }
 
+template <typename T>
+enable_if_t<
+    IsNonWeakReference<T>(),
+    shared_global_ref<plain_jni_reference_t<T>>>
+make_shared_global(const T& ref) {
+  return make_global(ref);
+}
+
 template <typename T1, typename T2>
 inline enable_if_t<IsNonWeakReference<T1>() && IsNonWeakReference<T2>(), bool>
 operator==(const T1& a, const T2& b) {
@@ -226,7 +239,11 @@ inline base_owned_ref<T, Alloc>::base_owned_ref(std::nullptr_t t) noexcept
 
 template <typename T, typename Alloc>
 inline base_owned_ref<T, Alloc>::base_owned_ref(const base_owned_ref& other)
-    : storage_{static_cast<javaobject>(Alloc{}.newReference(other.get()))} {}
+    : storage_{static_cast<javaobject>(Alloc{}.newReference(other.get()))} {
+  if (get()) {
+    internal::ReferenceAccountingHooks<Alloc>::adopted(get());
+  }
+}
 
 template <typename T, typename Alloc>
 template <typename U>
@@ -234,6 +251,9 @@ inline base_owned_ref<T, Alloc>::base_owned_ref(
     const base_owned_ref<U, Alloc>& other)
     : storage_{static_cast<javaobject>(Alloc{}.newReference(other.get()))} {
   static_assert(std::is_convertible<JniType<U>, javaobject>::value, "");
+  if (get()) {
+    internal::ReferenceAccountingHooks<Alloc>::adopted(get());
+  }
 }
 
 template <typename T, typename Alloc>
@@ -242,6 +262,9 @@ inline facebook::jni::base_owned_ref<T, Alloc>::base_owned_ref(
     : storage_(reference) {
   assert(Alloc{}.verifyReference(reference));
   internal::dbglog("New wrapped ref=%p this=%p", get(), this);
+  if (reference) {
+    internal::ReferenceAccountingHooks<Alloc>::adopted(reference);
+  }
 }
 
 template <typename T, typename Alloc>
@@ -277,6 +300,9 @@ template <typename T, typename Alloc>
 inline auto base_owned_ref<T, Alloc>::release() noexcept -> javaobject {
   auto value = get();
   internal::dbglog("Ref release ref=%p this=%p", value, this);
+  if (value) {
+    internal::ReferenceAccountingHooks<Alloc>::dropped(value);
+  }
   set(nullptr);
   return value;
 }
@@ -290,9 +316,13 @@ template <typename T, typename Alloc>
 inline void base_owned_ref<T, Alloc>::reset(javaobject reference) noexcept {
   if (get()) {
     assert(Alloc{}.verifyReference(reference));
+    internal::ReferenceAccountingHooks<Alloc>::dropped(get());
     Alloc{}.deleteReference(get());
   }
   set(reference);
+  if (reference) {
+    internal::ReferenceAccountingHooks<Alloc>::adopted(reference);
+  }
 }
 
 template <typename T, typename Alloc>
@@ -435,6 +465,11 @@ inline alias_ref<T>::alias_ref(
     const basic_strong_ref<TOther, AOther>& other) noexcept
     : storage_{other.get()} {}
 
+template <typename T>
+template <typename TOther, typename /* for SFINAE */>
+inline alias_ref<T>::alias_ref(const shared_global_ref<TOther>& other) noexcept
+    : storage_{other.get()} {}
+
 template <typename T>
 inline alias_ref<T>& alias_ref<T>::operator=(alias_ref other) noexcept {
   swap(*this, other);
@@ -481,6 +516,194 @@ inline void swap(alias_ref<T>& a, alias_ref<T>& b) noexcept {
   a.storage_.swap(b.storage_);
 }
 
+// shared_global_ref
+// ///////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+inline shared_global_ref<T>::shared_global_ref() noexcept
+    : storage_{nullptr}, count_{nullptr} {}
+
+template <typename T>
+inline shared_global_ref<T>::shared_global_ref(std::nullptr_t) noexcept
+    : storage_{nullptr}, count_{nullptr} {}
+
+template <typename T>
+template <typename TOther, typename /* for SFINAE */>
+inline shared_global_ref<T>::shared_global_ref(global_ref<TOther>&& ref)
+    : storage_{nullptr}, count_{nullptr} {
+  if (ref) {
+    // Allocate first so that ref still owns the reference if this throws.
+    count_ = new detail::SharedReferenceCount;
+    storage_.set(ref.release());
+    internal::ReferenceAccountingHooks<GlobalReferenceAllocator>::adopted(
+        get());
+  }
+}
+
+template <typename T>
+inline shared_global_ref<T>::shared_global_ref(
+    const shared_global_ref& other) noexcept
+    : storage_{other.get()}, count_{other.count_} {
+  if (count_) {
+    count_->count.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+template <typename TOther, typename /* for SFINAE */>
+inline shared_global_ref<T>::shared_global_ref(
+    const shared_global_ref<TOther>& other) noexcept
+    : storage_{other.get()}, count_{other.count_} {
+  if (count_) {
+    count_->count.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+inline shared_global_ref<T>::shared_global_ref(
+    shared_global_ref&& other) noexcept
+    : storage_{other.get()}, count_{other.count_} {
+  other.storage_.set(nullptr);
+  other.count_ = nullptr;
+}
+
+template <typename T>
+template <typename TOther, typename /* for SFINAE */>
+inline shared_global_ref<T>::shared_global_ref(
+    shared_global_ref<TOther>&& other) noexcept
+    : storage_{other.get()}, count_{other.count_} {
+  other.storage_.set(nullptr);
+  other.count_ = nullptr;
+}
+
+template <typename T>
+inline shared_global_ref<T>::~shared_global_ref() noexcept {
+  reset();
+}
+
+template <typename T>
+inline shared_global_ref<T>& shared_global_ref<T>::operator=(
+    const shared_global_ref& other) noexcept {
+  auto otherCopy = other;
+  swap(*this, otherCopy);
+  return *this;
+}
+
+template <typename T>
+inline shared_global_ref<T>& shared_global_ref<T>::operator=(
+    shared_global_ref&& other) noexcept {
+  auto otherCopy = std::move(other);
+  swap(*this, otherCopy);
+  return *this;
+}
+
+template <typename T>
+inline void shared_global_ref<T>::reset() noexcept {
+  if (count_ && count_->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete count_;
+#ifdef FBJNI_DEBUG_REFS
+    // Counted here, since the delete itself is compiled into libfbjni.
+    if (get()) {
+      ++internal::g_reference_stats.globals_deleted;
+    }
+#endif
+    detail::deleteSharedGlobalReference(get());
+  }
+  storage_.set(nullptr);
+  count_ = nullptr;
+}
+
+template <typename T>
+inline auto shared_global_ref<T>::get() const noexcept -> javaobject {
+  return storage_.jobj();
+}
+
+template <typename T>
+inline std::size_t shared_global_ref<T>::use_count() const noexcept {
+  return count_ ? count_->count.load(std::memory_order_relaxed) : 0;
+}
+
+template <typename T>
+inline shared_global_ref<T>::operator bool() const noexcept {
+  return get() != nullptr;
+}
+
+template <typename T>
+inline auto shared_global_ref<T>::operator->() noexcept -> Repr* {
+  return &storage_.get();
+}
+
+template <typename T>
+inline auto shared_global_ref<T>::operator->() const noexcept -> const Repr* {
+  return &storage_.get();
+}
+
+template <typename T>
+inline auto shared_global_ref<T>::operator*() noexcept -> Repr& {
+  return storage_.get();
+}
+
+template <typename T>
+inline auto shared_global_ref<T>::operator*() const noexcept -> const Repr& {
+  return storage_.get();
+}
+
+template <typename T>
+inline void swap(shared_global_ref<T>& a, shared_global_ref<T>& b) noexcept {
+  a.storage_.swap(b.storage_);
+  std::swap(a.count_, b.count_);
+}
+
+// JniLocalScope
+// ///////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+local_ref<plain_jni_reference_t<T>> JniLocalScope::pop(const T& result) {
+  return adopt_local(static_cast<plain_jni_reference_t<T>>(
+      popFrame(getPlainJniReference(result))));
+}
+
+template <typename T1, typename T2, typename... Ts>
+std::tuple<
+    local_ref<plain_jni_reference_t<T1>>,
+    local_ref<plain_jni_reference_t<T2>>,
+    local_ref<plain_jni_reference_t<Ts>>...>
+JniLocalScope::pop(const T1& result1, const T2& result2, const Ts&... results) {
+  jobject plainResults[] = {
+      getPlainJniReference(result1),
+      getPlainJniReference(result2),
+      getPlainJniReference(results)...};
+  constexpr std::size_t kCount = 2 + sizeof...(Ts);
+
+  // PopLocalFrame can only carry one reference out of the frame, so carry an
+  // array holding all of them.
+  auto array = static_cast<jobjectArray>(
+      JArrayClass<jobject>::newArray(kCount).release());
+  for (std::size_t i = 0; i < kCount; ++i) {
+    env_->SetObjectArrayElement(array, static_cast<jsize>(i), plainResults[i]);
+  }
+  array = static_cast<jobjectArray>(popFrame(array));
+  for (std::size_t i = 0; i < kCount; ++i) {
+    plainResults[i] = env_->GetObjectArrayElement(array, static_cast<jsize>(i));
+  }
+  env_->DeleteLocalRef(array);
+
+  return promoteResults<std::tuple<
+      local_ref<plain_jni_reference_t<T1>>,
+      local_ref<plain_jni_reference_t<T2>>,
+      local_ref<plain_jni_reference_t<Ts>>...>>(
+      plainResults, std::make_index_sequence<kCount>());
+}
+
+template <typename Tuple, std::size_t... Is>
+Tuple JniLocalScope::promoteResults(
+    jobject results[],
+    std::index_sequence<Is...>) {
+  return Tuple{adopt_local(
+      static_cast<typename std::tuple_element<Is, Tuple>::type::javaobject>(
+          results[Is]))...};
+}
+
 // Could reduce code duplication by using a pointer-to-function
 // template argument.  I'm not sure whether that would make the code
 // more maintainable (DRY), or less (too clever/confusing.).
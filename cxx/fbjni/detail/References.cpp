@@ -15,23 +15,69 @@
  */
 
 #include "References.h"
+#include "Log.h"
 
 namespace facebook {
 namespace jni {
 
-JniLocalScope::JniLocalScope(JNIEnv* env, jint capacity) : env_(env) {
+JniLocalScope::JniLocalScope(JNIEnv* env, jint capacity)
+    : env_(env), accountingMark_(kNoAccountingMark) {
   hasFrame_ = false;
   auto pushResult = env->PushLocalFrame(capacity);
   FACEBOOK_JNI_THROW_EXCEPTION_IF(pushResult < 0);
   hasFrame_ = true;
+  if (internal::isReferenceAccountingEnabled()) {
+    accountingMark_ = internal::accountFramePushed();
+  }
 }
 
+JniLocalScope::JniLocalScope(jint capacity)
+    : JniLocalScope(Environment::current(), capacity) {}
+
 JniLocalScope::~JniLocalScope() {
   if (hasFrame_) {
-    env_->PopLocalFrame(nullptr);
+    popFrame(nullptr);
+  }
+}
+
+void JniLocalScope::ensureCapacity(jint capacity) {
+  auto ensureResult = env_->EnsureLocalCapacity(capacity);
+  FACEBOOK_JNI_THROW_EXCEPTION_IF(ensureResult < 0);
+}
+
+jobject JniLocalScope::popFrame(jobject result) {
+  FBJNI_ASSERT(hasFrame_);
+  hasFrame_ = false;
+  if (accountingMark_ != kNoAccountingMark) {
+    internal::accountFramePopped(accountingMark_);
   }
+  return env_->PopLocalFrame(result);
 }
 
+namespace detail {
+
+void deleteSharedGlobalReference(jobject reference) noexcept {
+  if (!reference) {
+    return;
+  }
+  internal::ReferenceAccountingHooks<GlobalReferenceAllocator>::dropped(
+      reference);
+  if (currentOrNull()) {
+    GlobalReferenceAllocator{}.deleteReference(reference);
+    return;
+  }
+  // The last copy was dropped on a thread the VM doesn't know about, which is
+  // fine for a shared_global_ref (unlike a global_ref).
+  try {
+    ThreadScope scope;
+    GlobalReferenceAllocator{}.deleteReference(reference);
+  } catch (const std::exception& ex) {
+    FBJNI_LOGE("Leaking global reference %p: %s", reference, ex.what());
+  }
+}
+
+} // namespace detail
+
 namespace {
 
 #ifdef __ANDROID__
@@ -89,9 +89,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <jni.h>
 
@@ -142,6 +145,12 @@ JniType<T> getPlainJniReference(alias_ref<T> ref);
 template <typename T, typename Alloc>
 JniType<T> getPlainJniReference(const base_owned_ref<T, Alloc>& ref);
 
+/**
+ * Retrieve the plain JNI reference from a shared global reference.
+ */
+template <typename T>
+JniType<T> getPlainJniReference(const shared_global_ref<T>& ref);
+
 class JObject;
 class JClass;
 
@@ -242,6 +251,15 @@ struct PrimitiveOrJavaObjectType<T, enable_if_t<IsJavaClassType<T>(), void>> {
       "PrimitiveOrJavaObjectType<T> not idempotent");
 };
 
+// The count shared by all copies of a shared_global_ref.
+struct SharedReferenceCount {
+  std::atomic<std::size_t> count{1};
+};
+
+// Deletes the global reference owned by the last shared_global_ref, attaching
+// the current thread for the duration of the call if it isn't attached.
+void deleteSharedGlobalReference(jobject reference) noexcept;
+
 template <typename Repr>
 struct ReprStorage {
   explicit ReprStorage(JniType<Repr> obj) noexcept;
@@ -522,6 +540,20 @@ class basic_strong_ref : public base_owned_ref<T, Alloc> {
   basic_strong_ref(basic_strong_ref&& other) noexcept
       : base_owned_ref<T, Alloc>{std::move(other)} {}
 
+  /// Hands a local reference over to the enclosing JniLocalScope, without
+  /// creating a new reference. Only available for frame_local_ref.
+  template <
+      typename U,
+      typename A = Alloc,
+      typename = enable_if_t<
+          std::is_same<A, FrameLocalReferenceAllocator>::value &&
+              IsConvertible<JniType<U>, JniType<T>>(),
+          void>>
+  /* implicit */ basic_strong_ref(
+      basic_strong_ref<U, LocalReferenceAllocator>&& other) noexcept
+      : base_owned_ref<T, Alloc>{
+            static_cast<JniType<T>>(other.release())} {}
+
   /// Assignment operator (note creates a new reference)
   basic_strong_ref& operator=(const basic_strong_ref& other);
 
@@ -612,6 +644,12 @@ class alias_ref {
       typename = enable_if_t<IsConvertible<JniType<TOther>, javaobject>(), T>>
   alias_ref(const basic_strong_ref<TOther, AOther>& other) noexcept;
 
+  /// Wrap an existing shared global reference of a type convertible to T
+  template <
+      typename TOther,
+      typename = enable_if_t<IsConvertible<JniType<TOther>, javaobject>(), T>>
+  alias_ref(const shared_global_ref<TOther>& other) noexcept;
+
   /// Assignment operator
   alias_ref& operator=(alias_ref other) noexcept;
 
@@ -643,21 +681,189 @@ class alias_ref {
   friend void swap<T>(alias_ref& a, alias_ref& b) noexcept;
 };
 
+/// Swaps two shared global references of the same type
+template <typename T>
+void swap(shared_global_ref<T>& a, shared_global_ref<T>& b) noexcept;
+
+/**
+ * Create a new shared global reference from an existing reference. Only one
+ * global reference is created; further copies of the result share it.
+ *
+ * @param ref a plain JNI, alias, or strong reference
+ * @return a shared global reference (referring to null if the input does)
+ * @throws std::bad_alloc if the JNI reference could not be created
+ */
+template <typename T>
+enable_if_t<
+    IsNonWeakReference<T>(),
+    shared_global_ref<plain_jni_reference_t<T>>>
+make_shared_global(const T& ref);
+
+/**
+ * A reference counted owner of a single global reference. The semantics are
+ * those of std::shared_ptr: copies share the underlying JNI reference, and it
+ * is deleted when the last copy is destroyed.
+ *
+ * Copying a global_ref creates a new global reference, which goes through the
+ * VM's global reference table (and its lock) every time. Copying a
+ * shared_global_ref is a single atomic increment, so prefer it for objects that
+ * are captured by callbacks or handed between threads.
+ *
+ * Unlike global_ref, the last copy may be destroyed on a thread that isn't
+ * attached to the VM; the thread is then attached while the reference is
+ * deleted.
+ */
+template <typename T>
+class shared_global_ref {
+  using Repr = ReprType<T>;
+
+ public:
+  using javaobject = JniType<T>;
+
+  /// Create a null reference
+  shared_global_ref() noexcept;
+
+  /// Create a null reference
+  /* implicit */ shared_global_ref(std::nullptr_t) noexcept;
+
+  /// Take over the global reference owned by ref (no new reference is created)
+  template <
+      typename TOther,
+      typename = enable_if_t<IsConvertible<JniType<TOther>, javaobject>(), T>>
+  /* implicit */ shared_global_ref(global_ref<TOther>&& ref);
+
+  /// Copy constructor (shares the underlying reference)
+  shared_global_ref(const shared_global_ref& other) noexcept;
+
+  /// Share the reference of a shared global reference of a convertible type
+  template <
+      typename TOther,
+      typename = enable_if_t<IsConvertible<JniType<TOther>, javaobject>(), T>>
+  shared_global_ref(const shared_global_ref<TOther>& other) noexcept;
+
+  /// Transfers the share held by other to the new reference
+  shared_global_ref(shared_global_ref&& other) noexcept;
+
+  /// Transfers the share held by other of a convertible type
+  template <
+      typename TOther,
+      typename = enable_if_t<IsConvertible<JniType<TOther>, javaobject>(), T>>
+  shared_global_ref(shared_global_ref<TOther>&& other) noexcept;
+
+  /// Drops this share, deleting the reference if it was the last one
+  ~shared_global_ref() noexcept;
+
+  /// Assignment operator (shares the underlying reference)
+  shared_global_ref& operator=(const shared_global_ref& other) noexcept;
+
+  /// Assignment by moving the share of other
+  shared_global_ref& operator=(shared_global_ref&& other) noexcept;
+
+  /// Drop this share and set the reference to null
+  void reset() noexcept;
+
+  /// Get the plain JNI reference
+  javaobject get() const noexcept;
+
+  /// The number of shared_global_refs sharing the reference (0 if null). Like
+  /// std::shared_ptr::use_count, the value is approximate if the reference is
+  /// shared across threads.
+  std::size_t use_count() const noexcept;
+
+  /// Checks if the reference points to a non-null object
+  explicit operator bool() const noexcept;
+
+  /// Access the functionality provided by the object wrappers
+  Repr* operator->() noexcept;
+
+  /// Access the functionality provided by the object wrappers
+  const Repr* operator->() const noexcept;
+
+  /// Provide a reference to the underlying wrapper (be sure that it is non-null
+  /// before invoking)
+  Repr& operator*() noexcept;
+
+  /// Provide a const reference to the underlying wrapper (be sure that it is
+  /// non-null before invoking)
+  const Repr& operator*() const noexcept;
+
+ private:
+  detail::ReprStorage<Repr> storage_;
+  detail::SharedReferenceCount* count_;
+
+  template <typename TOther>
+  friend class shared_global_ref;
+  friend void swap<T>(shared_global_ref& a, shared_global_ref& b) noexcept;
+};
+
 /**
  * RAII object to create a local JNI frame, using PushLocalFrame/PopLocalFrame.
  *
  * This is useful when you have a call which is initiated from C++-land, and
  * therefore doesn't automatically get a local JNI frame managed for you by the
  * JNI framework.
+ *
+ * It is also useful in loops that create many temporaries. Holding them in
+ * frame_local_ref instead of local_ref skips the DeleteLocalRef each
+ * destructor would do; the whole frame is reclaimed by one PopLocalFrame
+ * instead. Results that need to outlive the frame are promoted by pop():
+ *
+ *   local_ref<JString> longest;
+ *   {
+ *     JniLocalScope scope(16);
+ *     frame_local_ref<JString> best;
+ *     for (auto& s : strings) {
+ *       frame_local_ref<JString> str = make_jstring(s);
+ *       ...
+ *     }
+ *     longest = scope.pop(best);
+ *   }
+ *
+ * A frame_local_ref (or a local_ref) created inside the scope must not be used
+ * after the frame is popped.
  */
 class JniLocalScope {
  public:
   JniLocalScope(JNIEnv* p_env, jint capacity);
+
+  /// Pushes a frame on the current thread's JNIEnv
+  explicit JniLocalScope(jint capacity);
+
   ~JniLocalScope();
 
+  JniLocalScope(const JniLocalScope&) = delete;
+  JniLocalScope& operator=(const JniLocalScope&) = delete;
+
+  /// Makes sure at least capacity more local references can be created in the
+  /// frame without growing the local reference table.
+  void ensureCapacity(jint capacity);
+
+  /// Pops the frame early, keeping result alive as a new local reference in the
+  /// enclosing frame.
+  template <typename T>
+  local_ref<plain_jni_reference_t<T>> pop(const T& result);
+
+  /// Pops the frame early, keeping each of the results alive as a new local
+  /// reference in the enclosing frame. This costs an extra Object[] and two JNI
+  /// calls per result.
+  template <typename T1, typename T2, typename... Ts>
+  std::tuple<
+      local_ref<plain_jni_reference_t<T1>>,
+      local_ref<plain_jni_reference_t<T2>>,
+      local_ref<plain_jni_reference_t<Ts>>...>
+  pop(const T1& result1, const T2& result2, const Ts&... results);
+
  private:
+  jobject popFrame(jobject result);
+
+  template <typename Tuple, std::size_t... Is>
+  Tuple promoteResults(jobject results[], std::index_sequence<Is...>);
+
+  static constexpr std::size_t kNoAccountingMark = ~std::size_t{0};
+
   JNIEnv* env_;
   bool hasFrame_;
+  std::size_t accountingMark_;
 };
 
 template <typename T, typename U>
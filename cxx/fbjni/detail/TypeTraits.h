@@ -149,7 +149,8 @@ struct is_non_weak_reference
           bool,
           IsPlainJniReference<T>() ||
               IsInstantiationOf<basic_strong_ref, T>() ||
-              IsInstantiationOf<alias_ref, T>()> {};
+              IsInstantiationOf<alias_ref, T>() ||
+              IsInstantiationOf<shared_global_ref, T>()> {};
 
 template <typename T>
 constexpr bool IsNonWeakReference() {
@@ -162,7 +163,8 @@ struct is_any_reference
           bool,
           IsPlainJniReference<T>() || IsInstantiationOf<weak_ref, T>() ||
               IsInstantiationOf<basic_strong_ref, T>() ||
-              IsInstantiationOf<alias_ref, T>()> {};
+              IsInstantiationOf<alias_ref, T>() ||
+              IsInstantiationOf<shared_global_ref, T>()> {};
 
 template <typename T>
 constexpr bool IsAnyReference() {
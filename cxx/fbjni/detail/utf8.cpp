@@ -279,6 +279,61 @@ std::string utf16toUTF8(
   return utf8String;
 }
 
+void utf8toUTF16(const uint8_t* utf8, size_t len, std::u16string& out) {
+  const char16_t kReplacement = 0xFFFD;
+  size_t i = 0;
+  while (i < len) {
+    uint8_t lead = utf8[i];
+    if (lead < kUtf8OneByteBoundary) {
+      out.push_back(lead);
+      i++;
+      continue;
+    }
+
+    size_t extra;
+    char32_t code;
+    if ((lead & 0xE0) == 0xC0) {
+      extra = 1;
+      code = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+      extra = 2;
+      code = lead & 0x0F;
+    } else if (isFourByteUTF8Encoding(&lead)) {
+      extra = 3;
+      code = lead & 0x07;
+    } else {
+      out.push_back(kReplacement);
+      i++;
+      continue;
+    }
+
+    // Stop at the first byte that isn't a continuation, so a truncated
+    // sequence doesn't swallow the character after it.
+    size_t j = 1;
+    for (; j <= extra && i + j < len && (utf8[i + j] & 0xC0) == 0x80; j++) {
+      code = (code << 6) | (utf8[i + j] & 0x3F);
+    }
+    if (j <= extra) {
+      out.push_back(kReplacement);
+      i += j;
+      continue;
+    }
+    i += j;
+
+    if (code < 0x10000) {
+      out.push_back(static_cast<char16_t>(code));
+    } else if (code < 0x110000) {
+      code -= 0x10000;
+      out.push_back(
+          static_cast<char16_t>(kUtf16HighSubLowBoundary + (code >> 10)));
+      out.push_back(
+          static_cast<char16_t>(kUtf16HighSubHighBoundary + (code & 0x3FF)));
+    } else {
+      out.push_back(kReplacement);
+    }
+  }
+}
+
 } // namespace detail
 } // namespace jni
 } // namespace facebook
@@ -35,6 +35,9 @@ size_t modifiedLength(const std::string& str);
 size_t modifiedLength(const uint8_t* str, size_t* length);
 std::string modifiedUTF8ToUTF8(const uint8_t* modified, size_t len) noexcept;
 std::string utf16toUTF8(const uint16_t* utf16Bytes, size_t len) noexcept;
+// Appends the UTF-16 encoding of a UTF-8 string to out. Malformed sequences
+// are replaced with U+FFFD rather than reported.
+void utf8toUTF16(const uint8_t* utf8, size_t len, std::u16string& out);
 
 } // namespace detail
 
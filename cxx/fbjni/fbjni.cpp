@@ -79,11 +79,15 @@ local_ref<JClass> findClassLocal(const char* name) {
 }
 
 alias_ref<JClass> findClassStatic(const char* name) {
+#ifdef FBJNI_SHARED_REGISTRY
+  return wrap_alias(detail::sharedClass(name));
+#else
   JNIEnv* env = detail::currentOrNull();
   auto cls = adopt_local(detail::findClass(env, name));
   auto leaking_ref = (jclass)env->NewGlobalRef(cls.get());
   FACEBOOK_JNI_THROW_EXCEPTION_IF(!leaking_ref);
   return wrap_alias(leaking_ref);
+#endif
 }
 
 // jstring
@@ -132,7 +136,7 @@ local_ref<JString> make_jstring(const char* utf8) {
         modified.size());
     result = env->NewStringUTF(modified.data());
   }
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
   return adopt_local(result);
 }
 
@@ -146,7 +150,7 @@ local_ref<JString> make_jstring(const std::u16string& utf16) {
       "Expecting jchar to be the same size as std::u16string::CharT");
   jstring result = env->NewString(
       reinterpret_cast<const jchar*>(utf16.c_str()), utf16.size());
-  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);
   return adopt_local(result);
 }
 
@@ -161,7 +165,7 @@ local_ref<JString> make_jstring(const std::u16string& utf16) {
   TYPE* JPrimitiveArray<TYPE##Array>::getElements(jboolean* isCopy) { \
     auto env = Environment::current();                                \
     TYPE* res = env->Get##NAME##ArrayElements(self(), isCopy);        \
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();                           \
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);                        \
     return res;                                                       \
   }                                                                   \
                                                                       \
@@ -170,7 +174,7 @@ local_ref<JString> make_jstring(const std::u16string& utf16) {
       TYPE* elements, jint mode) {                                    \
     auto env = Environment::current();                                \
     env->Release##NAME##ArrayElements(self(), elements, mode);        \
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();                           \
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);                        \
   }                                                                   \
                                                                       \
   template <>                                                         \
@@ -178,7 +182,7 @@ local_ref<JString> make_jstring(const std::u16string& utf16) {
       jsize start, jsize length, TYPE* buf) {                         \
     auto env = Environment::current();                                \
     env->Get##NAME##ArrayRegion(self(), start, length, buf);          \
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();                           \
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);                        \
   }                                                                   \
                                                                       \
   template <>                                                         \
@@ -186,7 +190,7 @@ local_ref<JString> make_jstring(const std::u16string& utf16) {
       jsize start, jsize length, const TYPE* elements) {              \
     auto env = Environment::current();                                \
     env->Set##NAME##ArrayRegion(self(), start, length, elements);     \
-    FACEBOOK_JNI_THROW_PENDING_EXCEPTION();                           \
+    FACEBOOK_JNI_THROW_PENDING_EXCEPTION(env);                        \
   }                                                                   \
                                                                       \
   local_ref<TYPE##Array> make_##SMALLNAME##_array(jsize size) {       \
@@ -19,15 +19,18 @@
 #include <jni.h>
 
 // IWYU pragma: begin_exports
+#include <fbjni/detail/BulkConversions.h>
 #include <fbjni/detail/Common.h>
 #include <fbjni/detail/CoreClasses.h>
 #include <fbjni/detail/Environment.h>
 #include <fbjni/detail/Exceptions.h>
 #include <fbjni/detail/Hybrid.h>
+#include <fbjni/detail/IdRegistry.h>
 #include <fbjni/detail/Iterator.h>
 #include <fbjni/detail/JWeakReference.h>
 #include <fbjni/detail/Log.h>
 #include <fbjni/detail/Meta.h>
+#include <fbjni/detail/ReferenceAccounting.h>
 #include <fbjni/detail/ReferenceAllocators.h>
 #include <fbjni/detail/References.h>
 #include <fbjni/detail/Registration.h>
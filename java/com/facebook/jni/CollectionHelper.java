@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Moves collections across JNI in bulk. Native code calls these once per collection instead of once
+ * or more per element.
+ *
+ * <p>Strings are passed as a single joined string plus an array holding the offset just past each
+ * part, which costs one string copy in each direction however many strings there are.
+ */
+@DoNotStrip
+class CollectionHelper {
+  /**
+   * Returns {joinedKeys, keyEnds, values}, where values is an Object[]. If joinValues is true the
+   * values must all be strings, and {joinedKeys, keyEnds, joinedValues, valueEnds} is returned
+   * instead.
+   */
+  @DoNotStrip
+  static Object[] flattenStringMap(Map<String, ?> map, boolean joinValues) {
+    int size = map.size();
+    StringBuilder keys = new StringBuilder();
+    int[] keyEnds = new int[size];
+    StringBuilder joinedValues = joinValues ? new StringBuilder() : null;
+    int[] valueEnds = joinValues ? new int[size] : null;
+    Object[] values = joinValues ? null : new Object[size];
+
+    int i = 0;
+    for (Map.Entry<String, ?> entry : map.entrySet()) {
+      keys.append(nonNull(entry.getKey(), "key"));
+      keyEnds[i] = keys.length();
+      if (joinValues) {
+        joinedValues.append((String) nonNull(entry.getValue(), "value"));
+        valueEnds[i] = joinedValues.length();
+      } else {
+        values[i] = entry.getValue();
+      }
+      i++;
+    }
+
+    return joinValues
+        ? new Object[] {keys.toString(), keyEnds, joinedValues.toString(), valueEnds}
+        : new Object[] {keys.toString(), keyEnds, values};
+  }
+
+  /**
+   * Returns {joined, ends} for the strings in list from {@code from} to {@code to}, or to the end of
+   * the list if {@code to} is negative.
+   */
+  @DoNotStrip
+  static Object[] joinStrings(List<?> list, int from, int to) {
+    List<?> slice = list.subList(from, to < 0 ? list.size() : to);
+    StringBuilder joined = new StringBuilder();
+    int[] ends = new int[slice.size()];
+    int i = 0;
+    for (Object string : slice) {
+      if (string == null) {
+        throw new NullPointerException("List contains a null string");
+      }
+      joined.append((String) string);
+      ends[i++] = joined.length();
+    }
+    return new Object[] {joined.toString(), ends};
+  }
+
+  @DoNotStrip
+  static Object[] joinStringArray(String[] strings) {
+    return joinStrings(Arrays.asList(strings), 0, strings.length);
+  }
+
+  @DoNotStrip
+  static String[] splitStrings(String joined, int[] ends) {
+    String[] strings = new String[ends.length];
+    int start = 0;
+    for (int i = 0; i < ends.length; i++) {
+      strings[i] = joined.substring(start, ends[i]);
+      start = ends[i];
+    }
+    return strings;
+  }
+
+  @DoNotStrip
+  static HashMap<String, Object> buildStringMap(
+      String keys, int[] keyEnds, String joinedValues, int[] valueEnds) {
+    HashMap<String, Object> map = new HashMap<>(capacityFor(keyEnds.length));
+    int keyStart = 0;
+    int valueStart = 0;
+    for (int i = 0; i < keyEnds.length; i++) {
+      map.put(
+          keys.substring(keyStart, keyEnds[i]), joinedValues.substring(valueStart, valueEnds[i]));
+      keyStart = keyEnds[i];
+      valueStart = valueEnds[i];
+    }
+    return map;
+  }
+
+  @DoNotStrip
+  static HashMap<String, Object> buildMap(String keys, int[] keyEnds, Object[] values) {
+    HashMap<String, Object> map = new HashMap<>(capacityFor(keyEnds.length));
+    int keyStart = 0;
+    for (int i = 0; i < keyEnds.length; i++) {
+      map.put(keys.substring(keyStart, keyEnds[i]), values[i]);
+      keyStart = keyEnds[i];
+    }
+    return map;
+  }
+
+  /** Returns the smallest HashMap capacity which holds size entries without rehashing. */
+  private static int capacityFor(int size) {
+    return size < 3 ? size + 1 : (int) (size / 0.75f + 1.0f);
+  }
+
+  private static Object nonNull(Object object, String what) {
+    if (object == null) {
+      throw new NullPointerException("Map contains a null " + what);
+    }
+    return object;
+  }
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.lang.reflect.Array;
+
+/**
+ * Rows of records stored as one array per field, so that native code can move many records across
+ * JNI with one bulk copy per field. Columns are primitive arrays or String arrays, all holding
+ * {@link #getRowCount()} elements.
+ *
+ * <p>Batches built in native code are read with the typed getters, for example {@code
+ * batch.getDoubleColumn("value")[row]}. To pass records the other way, build a batch from arrays:
+ *
+ * <pre>
+ * new ColumnarBatch(n, new String[] {"timestamp", "value"}, new Object[] {timestamps, values});
+ * </pre>
+ *
+ * <p>{@link #newObjects(Class, RowFactory)} turns a batch into one object per row, so that native
+ * code can create many objects with a single call into Java.
+ */
+@DoNotStrip
+public final class ColumnarBatch {
+  private final int mRowCount;
+  private final String[] mNames;
+  private final Object[] mColumns;
+
+  @DoNotStrip
+  public ColumnarBatch(int rowCount, String[] names, Object[] columns) {
+    if (names.length != columns.length) {
+      throw new IllegalArgumentException(
+          names.length + " column names for " + columns.length + " columns");
+    }
+    for (int i = 0; i < columns.length; i++) {
+      Object column = columns[i];
+      Class<?> type = column == null ? null : column.getClass().getComponentType();
+      if (type == null || !(type.isPrimitive() || type == String.class)) {
+        throw new IllegalArgumentException(
+            "Column " + names[i] + " is not a primitive or String array");
+      }
+      if (Array.getLength(column) != rowCount) {
+        throw new IllegalArgumentException(
+            "Column " + names[i] + " has " + Array.getLength(column) + " rows, not " + rowCount);
+      }
+    }
+    mRowCount = rowCount;
+    mNames = names;
+    mColumns = columns;
+  }
+
+  @DoNotStrip
+  public int getRowCount() {
+    return mRowCount;
+  }
+
+  public int getColumnCount() {
+    return mColumns.length;
+  }
+
+  public String getColumnName(int index) {
+    return mNames[index];
+  }
+
+  /** Returns the column with the given name, which is a primitive or String array. */
+  @DoNotStrip
+  public Object getColumn(String name) {
+    for (int i = 0; i < mNames.length; i++) {
+      if (mNames[i].equals(name)) {
+        return mColumns[i];
+      }
+    }
+    throw new IllegalArgumentException("No column named " + name);
+  }
+
+  public boolean[] getBooleanColumn(String name) {
+    return (boolean[]) getColumn(name);
+  }
+
+  public byte[] getByteColumn(String name) {
+    return (byte[]) getColumn(name);
+  }
+
+  public short[] getShortColumn(String name) {
+    return (short[]) getColumn(name);
+  }
+
+  public int[] getIntColumn(String name) {
+    return (int[]) getColumn(name);
+  }
+
+  public long[] getLongColumn(String name) {
+    return (long[]) getColumn(name);
+  }
+
+  public float[] getFloatColumn(String name) {
+    return (float[]) getColumn(name);
+  }
+
+  public double[] getDoubleColumn(String name) {
+    return (double[]) getColumn(name);
+  }
+
+  public String[] getStringColumn(String name) {
+    return (String[]) getColumn(name);
+  }
+
+  /** Creates the object for one row of a batch. */
+  public interface RowFactory<T> {
+    /**
+     * Returns the object for {@code row}, reading its values straight out of the typed columns,
+     * for example {@code batch.getLongColumn("timestamp")[row]}.
+     */
+    T create(ColumnarBatch batch, int row);
+  }
+
+  /**
+   * Creates one object per row with {@code factory}, in row order.
+   *
+   * @return an array whose runtime type is {@code type[]}
+   */
+  @DoNotStrip
+  public Object[] newObjects(Class<?> type, RowFactory<?> factory) {
+    Object[] objects = (Object[]) Array.newInstance(type, mRowCount);
+    for (int row = 0; row < mRowCount; row++) {
+      objects[row] = factory.create(this, row);
+    }
+    return objects;
+  }
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Queues calls into native code so that many of them cost a single JNI call. Each command is an
+ * opcode followed by primitive arguments, which a C++ handler registered for the opcode with
+ * {@code facebook::jni::JCommandQueue::on} reads back in the same order:
+ *
+ * <pre>
+ * queue.begin(MOVE_TO).putInt(id).putFloat(x).putFloat(y).end();
+ * </pre>
+ *
+ * <p>Commands are written straight into native memory, and run by {@link #flush()}, or when the
+ * queue fills up. Queues are created by native code, and are not thread safe.
+ */
+@DoNotStrip
+public final class CommandQueue {
+  private static final int HEADER_SIZE = 8;
+
+  private final HybridData mHybridData;
+  private final ByteBuffer mBuffer;
+  private int mCommandStart = -1;
+
+  private CommandQueue(HybridData hybridData) {
+    mHybridData = hybridData;
+    mBuffer = nativeGetBuffer().order(ByteOrder.nativeOrder());
+  }
+
+  /** Starts a command. Its arguments are added with the put methods, and {@link #end()} ends it. */
+  public CommandQueue begin(int opcode) {
+    if (mCommandStart >= 0) {
+      throw new IllegalStateException("The previous command has not ended");
+    }
+    reserve(HEADER_SIZE);
+    mCommandStart = mBuffer.position();
+    mBuffer.putInt(opcode).putInt(0);
+    return this;
+  }
+
+  public CommandQueue putBoolean(boolean value) {
+    return putByte(value ? (byte) 1 : (byte) 0);
+  }
+
+  public CommandQueue putByte(byte value) {
+    reserve(1);
+    mBuffer.put(value);
+    return this;
+  }
+
+  public CommandQueue putShort(short value) {
+    reserve(2);
+    mBuffer.putShort(value);
+    return this;
+  }
+
+  public CommandQueue putInt(int value) {
+    reserve(4);
+    mBuffer.putInt(value);
+    return this;
+  }
+
+  public CommandQueue putLong(long value) {
+    reserve(8);
+    mBuffer.putLong(value);
+    return this;
+  }
+
+  public CommandQueue putFloat(float value) {
+    reserve(4);
+    mBuffer.putFloat(value);
+    return this;
+  }
+
+  public CommandQueue putDouble(double value) {
+    reserve(8);
+    mBuffer.putDouble(value);
+    return this;
+  }
+
+  public void end() {
+    if (mCommandStart < 0) {
+      throw new IllegalStateException("No command has begun");
+    }
+    mBuffer.putInt(mCommandStart + 4, mBuffer.position() - mCommandStart - HEADER_SIZE);
+    mCommandStart = -1;
+  }
+
+  /** Runs every queued command. Exceptions thrown by handlers are rethrown here. */
+  public void flush() {
+    if (mCommandStart >= 0) {
+      throw new IllegalStateException("The last command has not ended");
+    }
+    run(mBuffer.position());
+  }
+
+  // Makes room for the next argument, by running the commands before the current one and moving
+  // it to the start of the buffer.
+  private void reserve(int bytes) {
+    if (mBuffer.remaining() >= bytes) {
+      return;
+    }
+    run(mCommandStart >= 0 ? mCommandStart : mBuffer.position());
+    if (mBuffer.remaining() < bytes) {
+      mCommandStart = -1;
+      mBuffer.clear();
+      throw new IllegalStateException("Command is larger than the queue");
+    }
+  }
+
+  private void run(int end) {
+    if (end == 0) {
+      return;
+    }
+    try {
+      nativeFlush(end);
+    } finally {
+      mBuffer.limit(mBuffer.position());
+      mBuffer.position(end);
+      mBuffer.compact();
+      if (mCommandStart >= 0) {
+        mCommandStart -= end;
+      }
+    }
+  }
+
+  private native ByteBuffer nativeGetBuffer();
+
+  private native void nativeFlush(int size);
+}
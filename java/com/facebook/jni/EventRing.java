@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Receives events written by native threads to a C++ {@code facebook::jni::EventRing}. The native
+ * side creates these, and one Java thread drains them:
+ *
+ * <pre>
+ * EventRing ring = nativeStartMetrics();
+ * while (ring.drain(handler, 1000) >= 0) {}
+ * </pre>
+ *
+ * <p>Each call to {@link #drain} takes one JNI call however many events it delivers, and blocks
+ * until at least one event is available. The producers never call into Java.
+ */
+@DoNotStrip
+public final class EventRing {
+  /** Receives one event, which is {@code length} bytes of {@code buffer} from {@code offset}. */
+  public interface Handler {
+    void onEvent(ByteBuffer buffer, int offset, int length);
+  }
+
+  private static final int HEADER_SIZE = 4;
+  private static final int ALIGNMENT = 4;
+  private static final int PADDING = -1;
+
+  private final HybridData mHybridData;
+  private final ByteBuffer mBuffer;
+  private final int mMask;
+  private int mReadOffset;
+  private int mConsumed;
+
+  private EventRing(HybridData hybridData) {
+    mHybridData = hybridData;
+    mBuffer = nativeGetBuffer().order(ByteOrder.nativeOrder());
+    mMask = mBuffer.capacity() - 1;
+  }
+
+  /**
+   * Waits up to {@code timeoutMs} for events, then passes each available event to the handler.
+   * The buffer passed to the handler is only valid during the call, and its position and limit
+   * must not be changed. Only one thread may drain a ring at a time.
+   *
+   * @return the number of events delivered, 0 on timeout, or -1 once the ring has been closed and
+   *     every event delivered
+   */
+  public int drain(Handler handler, long timeoutMs) {
+    int available = nativeAwaitBatch(mConsumed, timeoutMs);
+    mConsumed = 0;
+    if (available < 0) {
+      return -1;
+    }
+
+    int count = 0;
+    while (mConsumed < available) {
+      int offset = mReadOffset;
+      int length = mBuffer.getInt(offset);
+      int size;
+      if (length == PADDING) {
+        size = mBuffer.capacity() - offset;
+      } else {
+        size = (HEADER_SIZE + length + ALIGNMENT - 1) & -ALIGNMENT;
+      }
+      // Advance before calling the handler, so that an event that throws isn't redelivered.
+      mConsumed += size;
+      mReadOffset = (offset + size) & mMask;
+      if (length != PADDING) {
+        handler.onEvent(mBuffer, offset + HEADER_SIZE, length);
+        count++;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Stops producers from writing more events. Events already written are still delivered by
+   * {@link #drain}, which then returns -1.
+   */
+  public void close() {
+    nativeClose();
+  }
+
+  private native ByteBuffer nativeGetBuffer();
+
+  private native int nativeAwaitBatch(int consumed, long timeoutMs);
+
+  private native void nativeClose();
+}
@@ -56,4 +56,21 @@ public class IteratorHelper {
       return false;
     }
   }
+
+  /**
+   * Copies up to {@code buffer.length} elements into the start of buffer, and returns how many were
+   * copied. A return value smaller than the buffer length means the iterator is exhausted. Slots
+   * past the returned count are cleared so they don't keep stale elements alive.
+   */
+  @DoNotStrip
+  int fill(Object[] buffer) {
+    int count = 0;
+    while (count < buffer.length && mIterator.hasNext()) {
+      buffer[count++] = mIterator.next();
+    }
+    for (int i = count; i < buffer.length; i++) {
+      buffer[i] = null;
+    }
+    return count;
+  }
 }
@@ -55,4 +55,25 @@ public class MapIteratorHelper {
       return false;
     }
   }
+
+  /**
+   * Copies up to {@code keys.length} entries into the start of keys and values, which must be the
+   * same length, and returns how many were copied. A return value smaller than the array length
+   * means the map is exhausted. Slots past the returned count are cleared.
+   */
+  @DoNotStrip
+  int fill(Object[] keys, Object[] values) {
+    int count = 0;
+    while (count < keys.length && mIterator.hasNext()) {
+      Map.Entry entry = mIterator.next();
+      keys[count] = entry.getKey();
+      values[count] = entry.getValue();
+      count++;
+    }
+    for (int i = count; i < keys.length; i++) {
+      keys[i] = null;
+      values[i] = null;
+    }
+    return count;
+  }
 }
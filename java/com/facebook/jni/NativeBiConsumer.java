@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.util.function.BiConsumer;
+
+/**
+ * A BiConsumer that has a native accept implementation. Used to run native callbacks when a
+ * CompletableFuture completes. java.util.function is only available from Android API level 24.
+ */
+@DoNotStrip
+public class NativeBiConsumer implements BiConsumer<Object, Object> {
+
+  private final HybridData mHybridData;
+
+  private NativeBiConsumer(HybridData hybridData) {
+    mHybridData = hybridData;
+  }
+
+  @Override
+  public native void accept(Object t, Object u);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.util.AbstractList;
+import java.util.RandomAccess;
+
+/**
+ * A read-only List whose elements live in a native container. Elements are converted to Java
+ * objects each time they are read, so reading a few elements of a large list doesn't pay to convert
+ * the rest.
+ */
+@DoNotStrip
+public class NativeList extends AbstractList<Object> implements RandomAccess {
+
+  private final HybridData mHybridData;
+  private final int mSize;
+
+  private NativeList(HybridData hybridData) {
+    mHybridData = hybridData;
+    mSize = nativeSize();
+  }
+
+  @Override
+  public Object get(int index) {
+    if (index < 0 || index >= mSize) {
+      throw new IndexOutOfBoundsException("Index: " + index + ", Size: " + mSize);
+    }
+    return nativeGet(index);
+  }
+
+  @Override
+  public int size() {
+    return mSize;
+  }
+
+  private native int nativeSize();
+
+  private native Object nativeGet(int index);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.util.AbstractMap;
+import java.util.AbstractSet;
+import java.util.Iterator;
+import java.util.NoSuchElementException;
+import java.util.Set;
+import javax.annotation.Nullable;
+
+/**
+ * A read-only Map whose entries live in a native map. Lookups go to the native map, and keys and
+ * values are converted to Java objects only when they are read.
+ */
+@DoNotStrip
+public class NativeMap extends AbstractMap<Object, Object> {
+
+  private final HybridData mHybridData;
+  private final int mSize;
+  private @Nullable Set<Entry<Object, Object>> mEntrySet;
+
+  private NativeMap(HybridData hybridData) {
+    mHybridData = hybridData;
+    mSize = nativeSize();
+  }
+
+  @Override
+  public int size() {
+    return mSize;
+  }
+
+  @Override
+  public boolean containsKey(Object key) {
+    return nativeContainsKey(key);
+  }
+
+  @Override
+  public @Nullable Object get(Object key) {
+    return nativeGet(key);
+  }
+
+  @Override
+  public Set<Entry<Object, Object>> entrySet() {
+    if (mEntrySet == null) {
+      mEntrySet = new EntrySet();
+    }
+    return mEntrySet;
+  }
+
+  private class EntrySet extends AbstractSet<Entry<Object, Object>> {
+    @Override
+    public int size() {
+      return mSize;
+    }
+
+    @Override
+    public Iterator<Entry<Object, Object>> iterator() {
+      return new Iterator<Entry<Object, Object>>() {
+        private int mIndex;
+
+        @Override
+        public boolean hasNext() {
+          return mIndex < mSize;
+        }
+
+        @Override
+        public Entry<Object, Object> next() {
+          if (mIndex >= mSize) {
+            throw new NoSuchElementException();
+          }
+          int index = mIndex++;
+          return new SimpleImmutableEntry<>(nativeKeyAt(index), nativeValueAt(index));
+        }
+      };
+    }
+  }
+
+  private native int nativeSize();
+
+  private native boolean nativeContainsKey(Object key);
+
+  private native @Nullable Object nativeGet(Object key);
+
+  private native Object nativeKeyAt(int index);
+
+  private native Object nativeValueAt(int index);
+}
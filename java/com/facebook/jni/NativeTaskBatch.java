@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.util.concurrent.Executor;
+
+/**
+ * A batch of native tasks, submitted to an {@link Executor} with a single call from native code.
+ * Each task is wrapped in a small {@link Runnable} that runs it by index. Instances are recycled
+ * by native code once every task in the batch has run.
+ */
+@DoNotStrip
+public final class NativeTaskBatch {
+
+  private final HybridData mHybridData;
+
+  private NativeTaskBatch(HybridData hybridData) {
+    mHybridData = hybridData;
+  }
+
+  @DoNotStrip
+  private void submit(Executor executor, int count) {
+    int submitted = 0;
+    try {
+      for (; submitted < count; submitted++) {
+        executor.execute(new Task(this, submitted));
+      }
+    } finally {
+      if (submitted < count) {
+        // The executor threw, so the remaining tasks will never run.
+        nativeDiscard(submitted);
+      }
+    }
+  }
+
+  private native void nativeRun(int index);
+
+  private native void nativeDiscard(int first);
+
+  private static final class Task implements Runnable {
+    private final NativeTaskBatch mBatch;
+    private final int mIndex;
+
+    Task(NativeTaskBatch batch, int index) {
+      mBatch = batch;
+      mIndex = index;
+    }
+
+    @Override
+    public void run() {
+      mBatch.nativeRun(mIndex);
+    }
+  }
+}
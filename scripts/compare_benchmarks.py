@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compares two runs of fbjni-bench and fails if any benchmark regressed.
+
+Usage:
+  fbjni-bench --benchmark_format=json > baseline.json
+  ... upgrade fbjni ...
+  compare_benchmarks.py baseline.json current.json
+
+or, to run the benchmarks and compare in one step:
+  compare_benchmarks.py --run path/to/fbjni-bench baseline.json
+
+To see what a static, LTO build of fbjni gains over the shared library, use
+the run of a build configured with -DFBJNI_STATIC=ON -DFBJNI_LTO=ON as the
+current results against one of the default build as the baseline.
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+
+
+def load_times(results, metric):
+    """Returns {name: time in ns} for a Google Benchmark JSON result."""
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    # With --benchmark_repetitions, compare the medians.
+    repeated = any(b.get("run_type") == "aggregate" for b in results["benchmarks"])
+    times = {}
+    for benchmark in results["benchmarks"]:
+        if repeated:
+            if benchmark.get("aggregate_name") != "median":
+                continue
+            name = benchmark["run_name"]
+        else:
+            name = benchmark["name"]
+        times[name] = benchmark[metric] * scale[benchmark.get("time_unit", "ns")]
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="JSON output of the baseline run")
+    parser.add_argument(
+        "current", nargs="?", help="JSON output of the run to check"
+    )
+    parser.add_argument(
+        "--run", metavar="BINARY", help="run BINARY to get the current results"
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.10,
+        help="fail if a benchmark is slower by more than this fraction "
+        "(default: %(default)s)",
+    )
+    parser.add_argument(
+        "--metric",
+        choices=["real_time", "cpu_time"],
+        default="cpu_time",
+    )
+    args = parser.parse_args()
+    if (args.current is None) == (args.run is None):
+        parser.error("give exactly one of current and --run")
+
+    with open(args.baseline) as f:
+        baseline = load_times(json.load(f), args.metric)
+    if args.run:
+        output = subprocess.run(
+            [args.run, "--benchmark_format=json"],
+            check=True,
+            stdout=subprocess.PIPE,
+        ).stdout
+        current = load_times(json.loads(output), args.metric)
+    else:
+        with open(args.current) as f:
+            current = load_times(json.load(f), args.metric)
+
+    regressions = 0
+    width = max((len(name) for name in baseline), default=0)
+    for name in sorted(baseline):
+        if name not in current:
+            print("{:<{}}  missing from the current run".format(name, width))
+            continue
+        change = current[name] / baseline[name] - 1 if baseline[name] else 0
+        regressed = change > args.threshold
+        regressions += regressed
+        print(
+            "{:<{}}  {:12.1f} ns -> {:12.1f} ns  {:+7.1%}{}".format(
+                name,
+                width,
+                baseline[name],
+                current[name],
+                change,
+                "  REGRESSED" if regressed else "",
+            )
+        )
+
+    if regressions:
+        print(
+            "{} benchmark(s) regressed by more than {:.0%}".format(
+                regressions, args.threshold
+            )
+        )
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
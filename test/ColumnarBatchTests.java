@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+
+import org.junit.Test;
+
+public class ColumnarBatchTests extends BaseFBJniTests {
+  static class Sample {
+    static final ColumnarBatch.RowFactory<Sample> FACTORY =
+        new ColumnarBatch.RowFactory<Sample>() {
+          @Override
+          public Sample create(ColumnarBatch batch, int row) {
+            return new Sample(
+                batch.getLongColumn("timestamp")[row],
+                batch.getDoubleColumn("value")[row],
+                batch.getFloatColumn("weight")[row],
+                batch.getIntColumn("count")[row],
+                batch.getShortColumn("channel")[row],
+                batch.getBooleanColumn("valid")[row],
+                batch.getByteColumn("kind")[row],
+                batch.getStringColumn("label")[row]);
+          }
+        };
+
+    final long timestamp;
+    final double value;
+    final float weight;
+    final int count;
+    final short channel;
+    final boolean valid;
+    final byte kind;
+    final String label;
+
+    private Sample(
+        long timestamp,
+        double value,
+        float weight,
+        int count,
+        short channel,
+        boolean valid,
+        byte kind,
+        String label) {
+      this.timestamp = timestamp;
+      this.value = value;
+      this.weight = weight;
+      this.count = count;
+      this.channel = channel;
+      this.valid = valid;
+      this.kind = kind;
+      this.label = label;
+    }
+  }
+
+  @Test
+  public void testNativeToJava() {
+    ColumnarBatch batch = nativeMakeBatch(100);
+    assertThat(batch.getRowCount()).isEqualTo(100);
+    assertThat(batch.getColumnCount()).isEqualTo(8);
+    assertThat(batch.getColumnName(0)).isEqualTo("timestamp");
+
+    assertThat(batch.getLongColumn("timestamp")[3]).isEqualTo((1L << 40) | 3);
+    assertThat(batch.getDoubleColumn("value")[3]).isEqualTo(1.5);
+    assertThat(batch.getFloatColumn("weight")[4]).isEqualTo(1.0f);
+    assertThat(batch.getIntColumn("count")[5]).isEqualTo(-5);
+    assertThat(batch.getShortColumn("channel")[9]).isEqualTo((short) 2);
+    assertThat(batch.getBooleanColumn("valid")[2]).isTrue();
+    assertThat(batch.getBooleanColumn("valid")[3]).isFalse();
+    // Unsigned enum values keep their bits.
+    assertThat(batch.getByteColumn("kind")[0]).isEqualTo((byte) 1);
+    assertThat(batch.getByteColumn("kind")[1] & 0xff).isEqualTo(200);
+    assertThat(batch.getStringColumn("label")[42]).isEqualTo("label42");
+  }
+
+  @Test
+  public void testEmptyBatch() {
+    ColumnarBatch batch = nativeMakeBatch(0);
+    assertThat(batch.getRowCount()).isEqualTo(0);
+    assertThat(batch.getStringColumn("label")).isEmpty();
+    assertThat(nativeTestReadBatch(batch, 0)).isTrue();
+  }
+
+  @Test
+  public void testRoundTrip() {
+    assertThat(nativeTestReadBatch(nativeMakeBatch(1000), 1000)).isTrue();
+  }
+
+  @Test
+  public void testJavaToNative() {
+    int n = 10;
+    long[] timestamps = new long[n];
+    double[] values = new double[n];
+    float[] weights = new float[n];
+    int[] counts = new int[n];
+    short[] channels = new short[n];
+    boolean[] valid = new boolean[n];
+    byte[] kinds = new byte[n];
+    String[] labels = new String[n];
+    for (int i = 0; i < n; i++) {
+      timestamps[i] = (1L << 40) | i;
+      values[i] = i * 0.5;
+      weights[i] = i * 0.25f;
+      counts[i] = -i;
+      channels[i] = (short) (i % 7);
+      valid[i] = i % 2 == 0;
+      kinds[i] = (byte) (i % 3 == 0 ? 1 : 200);
+      labels[i] = "label" + i;
+    }
+
+    // Columns are found by name, so order doesn't matter and extra columns are ignored.
+    ColumnarBatch batch =
+        new ColumnarBatch(
+            n,
+            new String[] {
+              "label", "kind", "valid", "channel", "count", "weight", "value", "timestamp", "extra"
+            },
+            new Object[] {
+              labels, kinds, valid, channels, counts, weights, values, timestamps, new int[n]
+            });
+    assertThat(nativeTestReadBatch(batch, n)).isTrue();
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void testMissingColumn() {
+    ColumnarBatch batch = new ColumnarBatch(0, new String[0], new Object[0]);
+    nativeTestReadBatch(batch, 0);
+  }
+
+  @Test(expected = ClassCastException.class)
+  public void testWrongColumnType() {
+    ColumnarBatch batch = nativeMakeBatch(1);
+    Object[] columns = new Object[8];
+    String[] names = new String[8];
+    for (int i = 0; i < 8; i++) {
+      names[i] = batch.getColumnName(i);
+      columns[i] = batch.getColumn(names[i]);
+    }
+    columns[0] = new int[1];
+    nativeTestReadBatch(new ColumnarBatch(1, names, columns), 1);
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void testMismatchedColumnLength() {
+    new ColumnarBatch(2, new String[] {"a"}, new Object[] {new int[3]});
+  }
+
+  @Test
+  public void testNewObjects() {
+    Sample[] samples = nativeMakeObjects(100, Sample.FACTORY);
+    assertThat(samples).hasSize(100);
+    Sample sample = samples[42];
+    assertThat(sample.timestamp).isEqualTo((1L << 40) | 42);
+    assertThat(sample.value).isEqualTo(21.0);
+    assertThat(sample.weight).isEqualTo(10.5f);
+    assertThat(sample.count).isEqualTo(-42);
+    assertThat(sample.channel).isEqualTo((short) 0);
+    assertThat(sample.valid).isTrue();
+    assertThat(sample.kind).isEqualTo((byte) 1);
+    assertThat(sample.label).isEqualTo("label42");
+    assertThat(nativeMakeObjects(0, Sample.FACTORY)).isEmpty();
+  }
+
+  @Test(expected = ArrayStoreException.class)
+  public void testNewObjectsOfTheWrongType() {
+    nativeMakeBatch(1).newObjects(String.class, Sample.FACTORY);
+  }
+
+  private static native ColumnarBatch nativeMakeBatch(int count);
+
+  private static native Sample[] nativeMakeObjects(
+      int count, ColumnarBatch.RowFactory<Sample> factory);
+
+  private static native boolean nativeTestReadBatch(ColumnarBatch batch, int count);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+
+import org.junit.Before;
+import org.junit.Test;
+
+public class CommandQueueTests extends BaseFBJniTests {
+  private static final int ADD = 0;
+  private static final int MOVE = 1;
+  private static final int FAIL = 2;
+  private static final int UNREGISTERED = 3;
+
+  @Before
+  public void clearLog() {
+    nativeTakeLog();
+  }
+
+  @Test
+  public void testFlush() {
+    CommandQueue queue = nativeCreateQueue(1024);
+    queue.begin(ADD).putInt(3).end();
+    queue.begin(ADD).putInt(4).end();
+    assertThat(nativeTakeLog()).isEqualTo("sum 0;");
+    queue.flush();
+    assertThat(nativeTakeLog()).isEqualTo("sum 7;");
+    queue.flush();
+    assertThat(nativeTakeLog()).isEqualTo("sum 0;");
+  }
+
+  @Test
+  public void testArguments() {
+    CommandQueue queue = nativeCreateQueue(1024);
+    queue
+        .begin(MOVE)
+        .putLong(1L << 40)
+        .putFloat(1.5f)
+        .putDouble(-2.25)
+        .putBoolean(true)
+        .putShort((short) 7)
+        .putByte((byte) -1)
+        .end();
+    queue.flush();
+    assertThat(nativeTakeLog()).isEqualTo("sum 0;move 1099511627776 1.5 -2.25 1 7 -1;");
+  }
+
+  @Test
+  public void testFlushesWhenFull() {
+    // Room for a few commands at a time, and commands that straddle the end of the buffer.
+    CommandQueue queue = nativeCreateQueue(70);
+    for (int i = 1; i <= 1000; i++) {
+      queue.begin(ADD).putInt(i).end();
+    }
+    queue.flush();
+    assertThat(nativeTakeLog()).isEqualTo("sum 500500;");
+  }
+
+  @Test(expected = IllegalStateException.class)
+  public void testCommandTooLarge() {
+    CommandQueue queue = nativeCreateQueue(16);
+    queue.begin(MOVE).putLong(1).putFloat(1).putDouble(1);
+  }
+
+  @Test(expected = IllegalStateException.class)
+  public void testUnfinishedCommand() {
+    CommandQueue queue = nativeCreateQueue(1024);
+    queue.begin(ADD).putInt(1);
+    queue.flush();
+  }
+
+  @Test
+  public void testHandlerException() {
+    CommandQueue queue = nativeCreateQueue(1024);
+    queue.begin(ADD).putInt(1).end();
+    queue.begin(FAIL).end();
+    queue.begin(ADD).putInt(2).end();
+    try {
+      queue.flush();
+      throw new AssertionError("flush should have thrown");
+    } catch (RuntimeException e) {
+      assertThat(e.getMessage()).contains("failed");
+    }
+    // Commands after the failure are discarded, and the queue is still usable.
+    assertThat(nativeTakeLog()).isEqualTo("sum 1;");
+    queue.begin(ADD).putInt(5).end();
+    queue.flush();
+    assertThat(nativeTakeLog()).isEqualTo("sum 5;");
+  }
+
+  @Test(expected = RuntimeException.class)
+  public void testUnregisteredOpcode() {
+    CommandQueue queue = nativeCreateQueue(1024);
+    queue.begin(UNREGISTERED).end();
+    queue.flush();
+  }
+
+  @Test(expected = RuntimeException.class)
+  public void testMismatchedArguments() {
+    CommandQueue queue = nativeCreateQueue(1024);
+    queue.begin(ADD).putLong(1).end();
+    queue.flush();
+  }
+
+  private static native CommandQueue nativeCreateQueue(int capacity);
+
+  private static native String nativeTakeLog();
+}
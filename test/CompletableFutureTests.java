@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+import org.junit.Test;
+
+public class CompletableFutureTests extends BaseFBJniTests {
+  @Test
+  public void testWhenComplete() {
+    CompletableFuture<String> future = new CompletableFuture<>();
+    nativeWhenComplete(future);
+    assertThat(nativeTakeResult()).isEmpty();
+    future.complete("done");
+    assertThat(nativeTakeResult()).isEqualTo("value: done");
+  }
+
+  @Test
+  public void testWhenCompleteAlreadyDone() {
+    nativeWhenComplete(CompletableFuture.completedFuture("early"));
+    assertThat(nativeTakeResult()).isEqualTo("value: early");
+  }
+
+  @Test
+  public void testWhenCompleteExceptionally() {
+    CompletableFuture<String> future = new CompletableFuture<>();
+    nativeWhenComplete(future);
+    future.completeExceptionally(new IllegalStateException("boom"));
+    assertThat(nativeTakeResult()).contains("IllegalStateException").contains("boom");
+  }
+
+  @Test
+  public void testToNative() {
+    CompletableFuture<String> future = new CompletableFuture<>();
+    nativeWaitOnUnattachedThread(future);
+    future.complete("done");
+    assertThat(nativeTakeResult()).isEqualTo("value: done");
+  }
+
+  @Test
+  public void testToNativeExceptionally() {
+    CompletableFuture<String> future = new CompletableFuture<>();
+    nativeWaitOnUnattachedThread(future);
+    future.completeExceptionally(new IllegalStateException("boom"));
+    assertThat(nativeTakeResult()).contains("boom");
+  }
+
+  @Test
+  public void testFromNative() throws Exception {
+    List<CompletableFuture<String>> futures = new ArrayList<>();
+    for (int i = 0; i < 100; i++) {
+      futures.add(nativeFromNative("value" + i, false));
+    }
+    for (int i = 0; i < 100; i++) {
+      assertThat(futures.get(i).get(10, TimeUnit.SECONDS)).isEqualTo("value" + i);
+    }
+  }
+
+  @Test
+  public void testFromNativeExceptionally() throws Exception {
+    try {
+      nativeFromNative("boom", true).get(10, TimeUnit.SECONDS);
+      throw new AssertionError("get should have thrown");
+    } catch (ExecutionException e) {
+      assertThat(e.getCause()).isInstanceOf(CppException.class).hasMessageContaining("boom");
+    }
+  }
+
+  @Test
+  public void testBrokenPromise() throws Exception {
+    try {
+      nativeBrokenPromise().get(10, TimeUnit.SECONDS);
+      throw new AssertionError("get should have thrown");
+    } catch (ExecutionException e) {
+      assertThat(e.getCause()).isInstanceOf(CppException.class);
+    }
+  }
+
+  private static native void nativeWhenComplete(CompletableFuture<String> future);
+
+  private static native void nativeWaitOnUnattachedThread(CompletableFuture<String> future);
+
+  private static native String nativeTakeResult();
+
+  private static native CompletableFuture<String> nativeFromNative(String value, boolean fail);
+
+  private static native CompletableFuture<String> nativeBrokenPromise();
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+
+import com.facebook.soloader.nativeloader.NativeLoader;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+public class CoroutineTests extends BaseFBJniTests {
+  private ExecutorService mExecutor;
+
+  @BeforeClass
+  public static void setup() {
+    BaseFBJniTests.setup();
+    NativeLoader.loadLibrary("coroutine_tests");
+  }
+
+  @Before
+  public void startExecutor() {
+    mExecutor = Executors.newSingleThreadExecutor();
+  }
+
+  @After
+  public void stopExecutor() {
+    mExecutor.shutdown();
+  }
+
+  @Test
+  public void testAwaitFuture() throws Exception {
+    CompletableFuture<String> input = new CompletableFuture<>();
+    CompletableFuture<String> result = nativeAwaitAndAppend(input, "b");
+    assertThat(result.isDone()).isFalse();
+    input.complete("a");
+    assertThat(result.get(10, TimeUnit.SECONDS)).isEqualTo("ab");
+  }
+
+  @Test
+  public void testAwaitCompletedFuture() throws Exception {
+    CompletableFuture<String> result =
+        nativeAwaitAndAppend(CompletableFuture.completedFuture("a"), "b");
+    assertThat(result.isDone()).isTrue();
+    assertThat(result.get()).isEqualTo("ab");
+  }
+
+  @Test
+  public void testAwaitFailedFuture() throws Exception {
+    CompletableFuture<String> input = new CompletableFuture<>();
+    CompletableFuture<String> result = nativeAwaitAndAppend(input, "b");
+    input.completeExceptionally(new IllegalStateException("boom"));
+    try {
+      result.get(10, TimeUnit.SECONDS);
+      throw new AssertionError("get should have thrown");
+    } catch (ExecutionException e) {
+      assertThat(e.getCause()).isInstanceOf(IllegalStateException.class).hasMessage("boom");
+    }
+  }
+
+  @Test
+  public void testRunOn() throws Exception {
+    assertThat(nativeRunOn(mExecutor, false).get(10, TimeUnit.SECONDS)).isEqualTo("other thread");
+  }
+
+  @Test
+  public void testRunOnThrows() throws Exception {
+    try {
+      nativeRunOn(mExecutor, true).get(10, TimeUnit.SECONDS);
+      throw new AssertionError("get should have thrown");
+    } catch (ExecutionException e) {
+      assertThat(e.getCause()).isInstanceOf(CppException.class).hasMessageContaining("boom");
+    }
+  }
+
+  @Test
+  public void testResumeOn() throws Exception {
+    assertThat(nativeResumeOn(mExecutor).get(10, TimeUnit.SECONDS)).isNull();
+  }
+
+  private static native CompletableFuture<String> nativeAwaitAndAppend(
+      CompletableFuture<String> future, String suffix);
+
+  private static native CompletableFuture<String> nativeRunOn(Executor executor, boolean fail);
+
+  private static native CompletableFuture<Void> nativeResumeOn(Executor executor);
+}
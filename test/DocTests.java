@@ -241,6 +241,24 @@ public class DocTests extends BaseFBJniTests {
     receiveBuffer(transformed);
   }
   // END
+
+  // SECTION command_queue
+  static native CommandQueue createCommandQueue();
+
+  static native double commandQueueTotal();
+
+  @Test
+  public void testCommandQueue() {
+    CommandQueue queue = createCommandQueue();
+    for (int i = 0; i < 1000; i++) {
+      // Opcode 0 takes an int and a double.
+      queue.begin(0).putInt(i).putDouble(0.5).end();
+    }
+    // A single JNI call runs all of the commands.
+    queue.flush();
+    assertThat(commandQueueTotal()).isEqualTo(249750.0);
+  }
+  // END
 }
 
 // SECTION inheritance
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import org.junit.Test;
+
+public class DynamicMethodCacheTests extends BaseFBJniTests {
+  @DoNotStrip
+  public static class Greeter {
+    @DoNotStrip
+    public String greet(String name, int times) {
+      StringBuilder builder = new StringBuilder();
+      for (int i = 0; i < times; i++) {
+        builder.append("hello ").append(name).append(';');
+      }
+      return builder.toString();
+    }
+
+    @DoNotStrip
+    public static long add(long a, long b) {
+      return a + b;
+    }
+  }
+
+  @DoNotStrip
+  public static class LoudGreeter extends Greeter {
+    @Override
+    @DoNotStrip
+    public String greet(String name, int times) {
+      return super.greet(name, times).toUpperCase();
+    }
+  }
+
+  @Test
+  public void testInvoke() {
+    assertThat(nativeTestInvoke(new Greeter())).isTrue();
+  }
+
+  private static native boolean nativeTestInvoke(Greeter greeter);
+
+  @Test
+  public void testHitsSkipResolution() {
+    assertThat(nativeTestHitsSkipResolution(new Greeter())).isTrue();
+  }
+
+  private static native boolean nativeTestHitsSkipResolution(Greeter greeter);
+
+  @Test
+  public void testCallSite() {
+    assertThat(nativeTestCallSite(new Greeter(), new LoudGreeter())).isTrue();
+  }
+
+  private static native boolean nativeTestCallSite(Greeter greeter, Greeter loud);
+
+  @Test(expected = NoSuchMethodError.class)
+  public void testMissingMethod() {
+    nativeTestMissingMethod();
+  }
+
+  private static native void nativeTestMissingMethod();
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+
+import java.nio.ByteBuffer;
+import org.junit.Test;
+
+public class EventRingTests extends BaseFBJniTests {
+  private static final int THREADS = 4;
+  private static final int EVENTS_PER_THREAD = 100000;
+
+  private static class Counter implements EventRing.Handler {
+    long count;
+    long sum;
+
+    @Override
+    public void onEvent(ByteBuffer buffer, int offset, int length) {
+      assertThat(length).isEqualTo(8);
+      count++;
+      sum += buffer.getLong(offset);
+    }
+  }
+
+  // Drains ring while THREADS native threads write to it.
+  private static void drainWhileProducing(final EventRing ring, Counter counter)
+      throws InterruptedException {
+    Thread producer =
+        new Thread(
+            new Runnable() {
+              @Override
+              public void run() {
+                nativeProduce(ring, THREADS, EVENTS_PER_THREAD);
+              }
+            });
+    producer.start();
+    while (ring.drain(counter, 1000) >= 0) {}
+    producer.join();
+  }
+
+  private static long expectedSum() {
+    return (long) THREADS * EVENTS_PER_THREAD * (EVENTS_PER_THREAD - 1) / 2;
+  }
+
+  @Test
+  public void testDeliversEveryEvent() throws InterruptedException {
+    Counter counter = new Counter();
+    drainWhileProducing(nativeCreateRing(4096), counter);
+    assertThat(counter.count).isEqualTo((long) THREADS * EVENTS_PER_THREAD);
+    assertThat(counter.sum).isEqualTo(expectedSum());
+  }
+
+  @Test
+  public void testTimeout() {
+    EventRing ring = nativeCreateRing(4096);
+    assertThat(ring.drain(new Counter(), 10)).isEqualTo(0);
+    ring.close();
+    assertThat(ring.drain(new Counter(), 10)).isEqualTo(-1);
+  }
+
+  private static native EventRing nativeCreateRing(int capacity);
+
+  private static native void nativeProduce(EventRing ring, int threads, int eventsPerThread);
+}
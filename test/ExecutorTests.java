@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+import static org.junit.Assert.fail;
+
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
+import org.junit.Test;
+
+public class ExecutorTests extends BaseFBJniTests {
+  private static final Executor DIRECT =
+      new Executor() {
+        @Override
+        public void execute(Runnable command) {
+          command.run();
+        }
+      };
+
+  private static long expectedSum(int count) {
+    return (long) count * (count - 1) / 2;
+  }
+
+  @Test
+  public void testSubmitBatch() {
+    nativeSubmitBatch(DIRECT, 10);
+    assertThat(nativeAwaitTasks(10)).isEqualTo(expectedSum(10));
+  }
+
+  @Test
+  public void testSubmitBatchReusesHandles() throws InterruptedException {
+    ExecutorService pool = Executors.newFixedThreadPool(4);
+    try {
+      for (int i = 0; i < 100; i++) {
+        nativeSubmitBatch(pool, 100);
+        assertThat(nativeAwaitTasks(100)).isEqualTo(expectedSum(100));
+      }
+    } finally {
+      pool.shutdown();
+    }
+  }
+
+  @Test
+  public void testSubmitEmptyBatch() {
+    nativeSubmitBatch(DIRECT, 0);
+    assertThat(nativeAwaitTasks(0)).isEqualTo(0);
+  }
+
+  @Test
+  public void testTaskThrows() {
+    try {
+      nativeSubmitThrowing(DIRECT);
+      fail("expected an exception");
+    } catch (RuntimeException e) {
+      assertThat(e).hasMessageContaining("task failed");
+    }
+    nativeSubmitBatch(DIRECT, 10);
+    assertThat(nativeAwaitTasks(10)).isEqualTo(expectedSum(10));
+  }
+
+  @Test
+  public void testRejectedTasksAreReleased() {
+    Executor acceptsThree =
+        new Executor() {
+          private int mAccepted;
+
+          @Override
+          public void execute(Runnable command) {
+            if (mAccepted++ == 3) {
+              throw new RejectedExecutionException("full");
+            }
+            command.run();
+          }
+        };
+    assertThat(nativeSubmitRejected(acceptsThree, 10)).isEqualTo(0);
+    nativeSubmitBatch(DIRECT, 10);
+    assertThat(nativeAwaitTasks(10)).isEqualTo(expectedSum(10));
+  }
+
+  @Test
+  public void testSubmitEach() {
+    nativeSubmitEach(DIRECT, 10);
+    assertThat(nativeAwaitTasks(10)).isEqualTo(expectedSum(10));
+  }
+
+  private static native void nativeSubmitBatch(Executor executor, int count);
+
+  private static native void nativeSubmitEach(Executor executor, int count);
+
+  private static native void nativeSubmitThrowing(Executor executor);
+
+  private static native int nativeSubmitRejected(Executor executor, int count);
+
+  private static native long nativeAwaitTasks(int count);
+}
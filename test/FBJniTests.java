@@ -17,6 +17,8 @@
 package com.facebook.jni;
 
 import static org.assertj.core.api.Assertions.assertThat;
+import static org.mockito.Mockito.doThrow;
+import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
 
 import com.facebook.jni.annotations.DoNotStrip;
@@ -293,6 +295,34 @@ public class FBJniTests extends BaseFBJniTests {
 
   private native void nativeTestJMethodCallbacks(Callbacks callbacks);
 
+  @Test
+  public void callbacksUsingUncheckedScope() {
+    nativeTestUncheckedCallbacks(mCallbacksMock);
+    verify(mCallbacksMock).voidFoo();
+    verify(mCallbacksMock).intFoo();
+    verify(mCallbacksMock).stringFoo();
+  }
+
+  private native void nativeTestUncheckedCallbacks(Callbacks callbacks);
+
+  @Test
+  public void uncheckedScopeThrowsOnExit() {
+    doThrow(new IllegalStateException("from voidFoo")).when(mCallbacksMock).voidFoo();
+    thrown.expect(IllegalStateException.class);
+    thrown.expectMessage("from voidFoo");
+    nativeTestUncheckedScopeThrows(mCallbacksMock);
+  }
+
+  private native void nativeTestUncheckedScopeThrows(Callbacks callbacks);
+
+  @Test
+  public void callbacksUsingSlowCall() {
+    assertThat(nativeTestSlowCall(mCallbacksMock)).isTrue();
+    verify(mCallbacksMock, times(2)).intFoo();
+  }
+
+  private native boolean nativeTestSlowCall(Callbacks callbacks);
+
   @Test
   public void callbacksUsingJStaticMethod() {
     nativeTestJStaticMethodCallbacks();
@@ -418,6 +448,27 @@ public class FBJniTests extends BaseFBJniTests {
 
   private native boolean nativeTestAssignmentAndCopyConstructors();
 
+  @Test
+  public void testSharedGlobalRef() {
+    assertThat(nativeTestSharedGlobalRef()).isTrue();
+  }
+
+  private native boolean nativeTestSharedGlobalRef();
+
+  @Test
+  public void testFrameLocalRefs() {
+    assertThat(nativeTestFrameLocalRefs()).isTrue();
+  }
+
+  private native boolean nativeTestFrameLocalRefs();
+
+  @Test
+  public void testReferenceAccounting() {
+    assertThat(nativeTestReferenceAccounting()).isTrue();
+  }
+
+  private native boolean nativeTestReferenceAccounting();
+
   @Test
   public void testAssignmentAndCopyCrossTypes() {
     assertThat(nativeTestAssignmentAndCopyCrossTypes()).isTrue();
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import static org.assertj.core.api.Assertions.assertThat;
+
+import org.junit.Test;
+
+public class FieldBindingTests extends BaseFBJniTests {
+  static class Point {
+    int x;
+    int y;
+
+    Point() {}
+
+    Point(int x, int y) {
+      this.x = x;
+      this.y = y;
+    }
+  }
+
+  static class Marker {
+    long id;
+    double scale;
+    boolean visible;
+    byte shape;
+    String label;
+    Point position;
+  }
+
+  private static Marker makeMarker(int i) {
+    Marker marker = new Marker();
+    marker.id = (1L << 40) | i;
+    marker.scale = i * 0.5;
+    marker.visible = i % 2 == 0;
+    marker.shape = (byte) (i % 3 == 0 ? 1 : -2);
+    marker.label = "marker" + i;
+    marker.position = new Point(i, -i);
+    return marker;
+  }
+
+  private static void assertMarker(Marker marker, int i) {
+    assertThat(marker.id).isEqualTo((1L << 40) | i);
+    assertThat(marker.scale).isEqualTo(i * 0.5);
+    assertThat(marker.visible).isEqualTo(i % 2 == 0);
+    assertThat(marker.shape).isEqualTo((byte) (i % 3 == 0 ? 1 : -2));
+    assertThat(marker.label).isEqualTo("marker" + i);
+    assertThat(marker.position.x).isEqualTo(i);
+    assertThat(marker.position.y).isEqualTo(-i);
+  }
+
+  @Test
+  public void testNativeToJava() {
+    assertMarker(nativeMakeMarker(7), 7);
+  }
+
+  @Test
+  public void testJavaToNative() {
+    assertThat(nativeTestMarker(makeMarker(5), 5)).isTrue();
+  }
+
+  @Test
+  public void testNullFields() {
+    assertThat(nativeTestNullFields(new Marker())).isTrue();
+  }
+
+  @Test
+  public void testMidpoint() {
+    Point midpoint = nativeMidpoint(new Point(2, 10), new Point(4, -2));
+    assertThat(midpoint.x).isEqualTo(3);
+    assertThat(midpoint.y).isEqualTo(4);
+  }
+
+  @Test
+  public void testArrays() {
+    // Cross several local frames, and end partway through one.
+    for (int count : new int[] {0, 1, 32, 33, 100}) {
+      Marker[] markers = nativeMakeMarkers(count);
+      assertThat(markers).hasSize(count);
+      for (int i = 0; i < count; i++) {
+        assertMarker(markers[i], i);
+      }
+      assertThat(nativeTestMarkers(markers, count)).isTrue();
+    }
+  }
+
+  private static native Marker nativeMakeMarker(int i);
+
+  private static native Marker[] nativeMakeMarkers(int count);
+
+  private static native boolean nativeTestMarker(Marker marker, int i);
+
+  private static native boolean nativeTestMarkers(Marker[] markers, int count);
+
+  private static native boolean nativeTestNullFields(Marker marker);
+
+  private static native Point nativeMidpoint(Point a, Point b);
+}
@@ -83,4 +83,149 @@ public class IteratorTests extends BaseFBJniTests {
   }
 
   private static native boolean nativeTestLargeMapIteration(Map map);
+
+  @Test
+  public void testBatchBoundaries() {
+    // Native code reads elements out in batches of 64.
+    int[] sizes = {0, 1, 63, 64, 65, 128, 200};
+    for (int size : sizes) {
+      List<Integer> list = new ArrayList<Integer>();
+      Map<Integer, Object> map = new HashMap<Integer, Object>();
+      for (int i = 0; i < size; i++) {
+        list.add(i);
+        map.put(i, "value" + i);
+      }
+      assertThat(nativeTestBatchBoundaries(list, map)).isTrue();
+    }
+  }
+
+  private static native boolean nativeTestBatchBoundaries(List list, Map map);
+
+  @Test
+  public void testIterationCallBudget() {
+    List<Integer> list = new ArrayList<Integer>();
+    Map<Integer, Object> map = new HashMap<Integer, Object>();
+    for (int i = 0; i < 200; i++) {
+      list.add(i);
+      map.put(i, "value" + i);
+    }
+    assertThat(nativeTestIterationCallBudget(list, map)).isTrue();
+  }
+
+  private static native boolean nativeTestIterationCallBudget(List list, Map map);
+
+  @Test
+  public void testToUnorderedMap() {
+    Map<String, Integer> counts = new HashMap<String, Integer>();
+    counts.put("one", 1);
+    counts.put("two", 2);
+    counts.put("", 0);
+    Map<String, String> names = new HashMap<String, String>();
+    names.put("ascii", "plain");
+    names.put("\u00e9t\u00e9", "\u20ac");
+    names.put("\ud83d\ude00", "");
+
+    assertThat(nativeTestToUnorderedMap(counts, names)).isTrue();
+  }
+
+  private static native boolean nativeTestToUnorderedMap(Map counts, Map names);
+
+  @Test(expected = NullPointerException.class)
+  public void testToUnorderedMapNullKey() {
+    Map<String, String> names = new HashMap<String, String>();
+    names.put("ascii", "plain");
+    names.put(null, "null");
+
+    nativeTestToUnorderedMap(new HashMap<String, Integer>(), names);
+  }
+
+  @Test
+  public void testToJavaHashMap() {
+    Map<String, Integer> counts = nativeToJavaHashMap();
+    assertThat(counts).hasSize(3);
+    assertThat(counts.get("one")).isEqualTo(1);
+    assertThat(counts.get("\ud83d\ude00")).isEqualTo(2);
+    assertThat(counts.get("")).isEqualTo(3);
+
+    Map<String, String> names = nativeToJavaStringHashMap();
+    assertThat(names).hasSize(3);
+    assertThat(names.get("ascii")).isEqualTo("plain");
+    assertThat(names.get("\u00e9t\u00e9")).isEqualTo("\u20ac");
+    assertThat(names.get("empty")).isEqualTo("");
+  }
+
+  private static native Map<String, Integer> nativeToJavaHashMap();
+
+  private static native Map<String, String> nativeToJavaStringHashMap();
+
+  @Test
+  public void testListRandomAccess() {
+    List<String> list = new ArrayList<String>();
+    list.add("zero");
+    list.add("one");
+    list.add("two");
+    list.add("three");
+    list.add("four");
+
+    assertThat(nativeTestListRandomAccess(list)).isTrue();
+    assertThat(list.get(2)).isEqualTo("TWO");
+  }
+
+  private static native boolean nativeTestListRandomAccess(List list);
+
+  @Test
+  public void testNativeList() {
+    List<?> list = nativeCreateNativeList(1000);
+    assertThat(list).isInstanceOf(NativeList.class);
+    assertThat(list).hasSize(1000);
+    assertThat(list.get(0)).isEqualTo("name0");
+    assertThat(list.get(999)).isEqualTo("name999");
+    assertThat(list.subList(10, 12)).containsExactly("name10", "name11");
+
+    assertThat(nativeCreateNativeList(0)).isEmpty();
+    assertThat(nativeCreateConvertedNativeList()).containsExactly(10, 20, 30);
+  }
+
+  @Test(expected = IndexOutOfBoundsException.class)
+  public void testNativeListOutOfBounds() {
+    nativeCreateNativeList(3).get(3);
+  }
+
+  @Test(expected = UnsupportedOperationException.class)
+  public void testNativeListIsReadOnly() {
+    List<Object> list = (List<Object>) nativeCreateNativeList(3);
+    list.set(0, "other");
+  }
+
+  private static native List<?> nativeCreateNativeList(int size);
+
+  private static native List<?> nativeCreateConvertedNativeList();
+
+  @Test
+  public void testNativeMap() {
+    Map<?, ?> map = nativeCreateNativeMap();
+    assertThat(map).isInstanceOf(NativeMap.class);
+    assertThat(map).hasSize(3);
+    assertThat(map.get("two")).isEqualTo("dos");
+    assertThat(map.get("four")).isNull();
+    assertThat(map.get(2)).isNull();
+    assertThat(map.containsKey("three")).isTrue();
+    assertThat(map.containsKey("four")).isFalse();
+
+    Map<String, String> expected = new HashMap<String, String>();
+    expected.put("one", "uno");
+    expected.put("two", "dos");
+    expected.put("three", "tres");
+    assertThat(map).isEqualTo(expected);
+    assertThat(new HashMap<Object, Object>(map)).isEqualTo(expected);
+
+    Map<?, ?> intKeyed = nativeCreateIntKeyedNativeMap();
+    assertThat(intKeyed.get(1)).isEqualTo(1.5);
+    assertThat(intKeyed.get(1L)).isNull();
+    assertThat(intKeyed.keySet()).containsExactlyInAnyOrder(1, 2);
+  }
+
+  private static native Map<?, ?> nativeCreateNativeMap();
+
+  private static native Map<?, ?> nativeCreateIntKeyedNativeMap();
 }
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.facebook.jni;
+
+import com.facebook.jni.annotations.DoNotStrip;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.Executor;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadFactory;
+
+/**
+ * The Java half of fbjni-bench (test/jni/fbjni_bench.cpp). Not a test: the benchmarks call into
+ * this class from C++ in an embedded JVM. The call* loops call a native method count times, so
+ * that calls from Java into C++ can be timed without the cost of getting there from C++.
+ */
+@DoNotStrip
+public class JniBenchmarks {
+
+  /** A hybrid with a single native method, for hybrid calls and creating and destroying. */
+  @DoNotStrip
+  static class Hybrid {
+    private final HybridData mHybridData;
+
+    private Hybrid(HybridData hybridData) {
+      mHybridData = hybridData;
+    }
+
+    @DoNotStrip
+    void call(int count) {
+      for (int i = 0; i < count; i++) {
+        nativeCall(i);
+      }
+    }
+
+    @DoNotStrip
+    void destroy() {
+      mHybridData.resetNative();
+    }
+
+    private native void nativeCall(int i);
+  }
+
+  // Targets for calls from C++ into Java.
+
+  @DoNotStrip
+  static void noArgs() {}
+
+  @DoNotStrip
+  static int intArgs(int a, int b, int c, int d) {
+    return a + b + c + d;
+  }
+
+  @DoNotStrip
+  static long longReturn() {
+    return 42;
+  }
+
+  @DoNotStrip
+  static double doubleReturn() {
+    return 0.5;
+  }
+
+  @DoNotStrip
+  static Object objectArgs(Object a, Object b) {
+    return a;
+  }
+
+  @DoNotStrip
+  static String stringReturn() {
+    return "benchmark";
+  }
+
+  @DoNotStrip
+  static void throwException() {
+    throw new IllegalStateException("benchmark");
+  }
+
+  @DoNotStrip
+  static List<Integer> makeList(int size) {
+    List<Integer> list = new ArrayList<>(size);
+    for (int i = 0; i < size; i++) {
+      list.add(i);
+    }
+    return list;
+  }
+
+  /** A pool of daemon threads, so that it doesn't keep the JVM alive. */
+  @DoNotStrip
+  static Executor makePool(int threads) {
+    return Executors.newFixedThreadPool(
+        threads,
+        new ThreadFactory() {
+          @Override
+          public Thread newThread(Runnable runnable) {
+            Thread thread = new Thread(runnable);
+            thread.setDaemon(true);
+            return thread;
+          }
+        });
+  }
+
+  @DoNotStrip
+  static Map<String, Integer> makeMap(int size) {
+    Map<String, Integer> map = new HashMap<>(size);
+    for (int i = 0; i < size; i++) {
+      map.put(Integer.toString(i), i);
+    }
+    return map;
+  }
+
+  // Loops for calls from Java into C++, one per registration flavor.
+
+  @DoNotStrip
+  static void callBare(int count) {
+    for (int i = 0; i < count; i++) {
+      nativeBare(i);
+    }
+  }
+
+  @DoNotStrip
+  static void callWrapped(int count) {
+    for (int i = 0; i < count; i++) {
+      nativeWrapped(i);
+    }
+  }
+
+  @DoNotStrip
+  static void callAliasRef(int count, Object obj) {
+    for (int i = 0; i < count; i++) {
+      nativeAliasRef(obj);
+    }
+  }
+
+  @DoNotStrip
+  static void callCritical(int count) {
+    for (int i = 0; i < count; i++) {
+      nativeCritical(i);
+    }
+  }
+
+  @DoNotStrip
+  static void callThrowing(int count) {
+    for (int i = 0; i < count; i++) {
+      try {
+        nativeThrow();
+      } catch (RuntimeException e) {
+        // Expected.
+      }
+    }
+  }
+
+  private static native void nativeBare(int i);
+
+  private static native void nativeWrapped(int i);
+
+  private static native void nativeAliasRef(Object obj);
+
+  private static native void nativeCritical(int i);
+
+  private static native void nativeThrow();
+}
@@ -604,4 +604,20 @@ public class PrimitiveArrayTests extends BaseFBJniTests {
   private native boolean nativeTestCopiedPinnedArray(int[] array);
 
   private native boolean nativeTestNonCopiedPinnedArray(int[] array);
+
+  @Test
+  public void testIntArrayCallBudget() {
+    int[] array = new int[MAGIC];
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = i;
+    }
+
+    assertThat(nativeTestIntArrayCallBudget(array)).isTrue();
+
+    for (int i = 0; i < array.length; ++i) {
+      assertThat(array[i]).isEqualTo(i + 1);
+    }
+  }
+
+  private static native boolean nativeTestIntArrayCallBudget(int[] array);
 }
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fbjni/ColumnarBatch.h>
+#include <fbjni/fbjni.h>
+
+#include "expect.h"
+
+using namespace facebook::jni;
+
+namespace {
+
+enum class Kind : uint8_t { Small = 1, Large = 200 };
+
+struct Sample {
+  int64_t timestamp;
+  double value;
+  float weight;
+  int32_t count;
+  int16_t channel;
+  bool valid;
+  Kind kind;
+  std::string label;
+};
+
+const auto kSampleColumns = makeColumns(
+    column("timestamp", &Sample::timestamp),
+    column("value", &Sample::value),
+    column("weight", &Sample::weight),
+    column("count", &Sample::count),
+    column("channel", &Sample::channel),
+    column("valid", &Sample::valid),
+    column("kind", &Sample::kind),
+    column("label", &Sample::label));
+
+struct JSample : JavaClass<JSample> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/jni/ColumnarBatchTests$Sample;";
+};
+
+std::vector<Sample> makeSamples(int count) {
+  std::vector<Sample> samples;
+  for (int i = 0; i < count; ++i) {
+    samples.push_back(Sample{
+        int64_t{1} << 40 | i,
+        i * 0.5,
+        i * 0.25f,
+        -i,
+        static_cast<int16_t>(i % 7),
+        i % 2 == 0,
+        i % 3 == 0 ? Kind::Small : Kind::Large,
+        "label" + std::to_string(i)});
+  }
+  return samples;
+}
+
+} // namespace
+
+local_ref<JColumnarBatch> nativeMakeBatch(alias_ref<jclass>, jint count) {
+  return kSampleColumns.toJava(makeSamples(count));
+}
+
+local_ref<JArrayClass<JSample::javaobject>> nativeMakeObjects(
+    alias_ref<jclass>,
+    jint count,
+    alias_ref<JColumnarBatch::JRowFactory> factory) {
+  return kSampleColumns.newObjects<JSample>(factory, makeSamples(count));
+}
+
+jboolean nativeTestReadBatch(
+    alias_ref<jclass>,
+    alias_ref<JColumnarBatch> batch,
+    jint count) {
+  auto samples = kSampleColumns.fromJava(batch);
+  auto expected = makeSamples(count);
+  EXPECT(samples.size() == expected.size());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    EXPECT(samples[i].timestamp == expected[i].timestamp);
+    EXPECT(samples[i].value == expected[i].value);
+    EXPECT(samples[i].weight == expected[i].weight);
+    EXPECT(samples[i].count == expected[i].count);
+    EXPECT(samples[i].channel == expected[i].channel);
+    EXPECT(samples[i].valid == expected[i].valid);
+    EXPECT(samples[i].kind == expected[i].kind);
+    EXPECT(samples[i].label == expected[i].label);
+  }
+  return JNI_TRUE;
+}
+
+void RegisterColumnarBatchTests() {
+  registerNatives(
+      "com/facebook/jni/ColumnarBatchTests",
+      {
+          makeNativeMethod("nativeMakeBatch", nativeMakeBatch),
+          makeNativeMethod("nativeMakeObjects", nativeMakeObjects),
+          makeNativeMethod("nativeTestReadBatch", nativeTestReadBatch),
+      });
+}
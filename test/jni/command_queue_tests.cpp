@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <fbjni/CommandQueue.h>
+#include <fbjni/fbjni.h>
+
+using namespace facebook::jni;
+
+namespace {
+
+enum Opcode : jint { kAdd = 0, kMove = 1, kFail = 2, kUnregistered = 3 };
+
+// What the handlers have done since the last nativeTakeLog.
+jlong sum = 0;
+std::ostringstream log;
+
+} // namespace
+
+local_ref<JCommandQueue::jhybridobject> nativeCreateQueue(
+    alias_ref<jclass>,
+    jint capacity) {
+  auto queue = JCommandQueue::create(capacity);
+  queue->cthis()->on<jint>(kAdd, [](jint value) { sum += value; });
+  queue->cthis()->on<jlong, jfloat, jdouble, bool, jshort, jbyte>(
+      kMove,
+      [](jlong id,
+         jfloat x,
+         jdouble y,
+         bool visible,
+         jshort layer,
+         jbyte flags) {
+        log << "move " << id << " " << x << " " << y << " " << visible << " "
+            << layer << " " << static_cast<int>(flags) << ";";
+      });
+  queue->cthis()->on(kFail, [] { throw std::runtime_error("failed"); });
+  return queue;
+}
+
+std::string nativeTakeLog(alias_ref<jclass>) {
+  std::string result = "sum " + std::to_string(sum) + ";" + log.str();
+  sum = 0;
+  log.str("");
+  return result;
+}
+
+void RegisterCommandQueueTests() {
+  registerNatives(
+      "com/facebook/jni/CommandQueueTests",
+      {
+          makeNativeMethod("nativeCreateQueue", nativeCreateQueue),
+          makeNativeMethod("nativeTakeLog", nativeTakeLog),
+      });
+}
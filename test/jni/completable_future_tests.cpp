@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <fbjni/CompletableFuture.h>
+#include <fbjni/fbjni.h>
+
+using namespace facebook::jni;
+
+namespace {
+
+std::mutex resultMutex;
+std::string result;
+
+void setResult(std::string value) {
+  std::lock_guard<std::mutex> lock(resultMutex);
+  result = std::move(value);
+}
+
+std::thread waiter;
+
+} // namespace
+
+void nativeWhenComplete(
+    alias_ref<jclass>,
+    alias_ref<JCompletableFuture<JString>> future) {
+  future->whenComplete(
+      [](alias_ref<JString> value, alias_ref<JThrowable> error) {
+        if (error) {
+          setResult(std::string("error: ") + JniException(error).what());
+        } else {
+          setResult("value: " + value->toStdString());
+        }
+      });
+}
+
+// Reads the future's value from a thread that isn't attached to the VM.
+void nativeWaitOnUnattachedThread(
+    alias_ref<jclass>,
+    alias_ref<JCompletableFuture<JString>> future) {
+  auto value = future->toNative(
+      [](alias_ref<JString> str) { return str->toStdString(); });
+  waiter = std::thread([value = std::move(value)]() mutable {
+    try {
+      setResult("value: " + value.get());
+    } catch (const std::exception& e) {
+      setResult(std::string("error: ") + e.what());
+    }
+  });
+}
+
+std::string nativeTakeResult(alias_ref<jclass>) {
+  if (waiter.joinable()) {
+    waiter.join();
+  }
+  std::lock_guard<std::mutex> lock(resultMutex);
+  return std::move(result);
+}
+
+// Completes the future from a new, unattached thread.
+local_ref<JCompletableFuture<JString>::javaobject>
+nativeFromNative(alias_ref<jclass>, std::string value, jboolean fail) {
+  return JCompletableFuture<JString>::fromNative(
+      [&](NativePromise<JString> promise) {
+        std::thread([promise, value, fail]() mutable {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          if (fail) {
+            promise.setException(
+                std::make_exception_ptr(std::runtime_error(value)));
+          } else {
+            promise.setWith([&] { return make_jstring(value); });
+          }
+        }).detach();
+      });
+}
+
+local_ref<JCompletableFuture<JString>::javaobject> nativeBrokenPromise(
+    alias_ref<jclass>) {
+  return JCompletableFuture<JString>::fromNative(
+      [](NativePromise<JString> promise) {
+        std::thread([promise]() mutable {
+          // Dropping the last copy fails the future.
+          auto dropped = std::move(promise);
+        }).detach();
+      });
+}
+
+void RegisterCompletableFutureTests() {
+  registerNatives(
+      "com/facebook/jni/CompletableFutureTests",
+      {
+          makeNativeMethod("nativeWhenComplete", nativeWhenComplete),
+          makeNativeMethod(
+              "nativeWaitOnUnattachedThread", nativeWaitOnUnattachedThread),
+          makeNativeMethod("nativeTakeResult", nativeTakeResult),
+          makeNativeMethod("nativeFromNative", nativeFromNative),
+          makeNativeMethod("nativeBrokenPromise", nativeBrokenPromise),
+      });
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Built as C++20, in its own library, since the rest of the tests are C++14.
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fbjni/Coroutines.h>
+#include <fbjni/fbjni.h>
+
+using namespace facebook::jni;
+
+#ifdef FBJNI_HAS_COROUTINES
+
+namespace {
+
+JniTask<JString> awaitAndAppend(
+    alias_ref<jclass>,
+    alias_ref<JCompletableFuture<JString>> future,
+    std::string suffix) {
+  global_ref<JString> value = co_await future;
+  co_return make_jstring(value->toStdString() + suffix);
+}
+
+JniTask<JString> runOnExecutor(
+    alias_ref<jclass>,
+    alias_ref<JExecutor> executor,
+    jboolean fail) {
+  auto caller = std::this_thread::get_id();
+  bool otherThread = co_await runOn(executor, [&] {
+    if (fail) {
+      throw std::runtime_error("boom");
+    }
+    return std::this_thread::get_id() != caller;
+  });
+  // Still on the executor's thread, with a usable JNIEnv.
+  co_return make_jstring(otherThread ? "other thread" : "same thread");
+}
+
+JniTask<> resumeOnExecutor(alias_ref<jclass>, alias_ref<JExecutor> executor) {
+  co_await resumeOn(executor);
+  co_return;
+}
+
+} // namespace
+
+jint JNI_OnLoad(JavaVM* vm, void*) {
+  return facebook::jni::initialize(vm, [] {
+    registerNatives(
+        "com/facebook/jni/CoroutineTests",
+        {
+            makeNativeMethod("nativeAwaitAndAppend", awaitAndAppend),
+            makeNativeMethod("nativeRunOn", runOnExecutor),
+            makeNativeMethod("nativeResumeOn", resumeOnExecutor),
+        });
+  });
+}
+
+#else
+
+jint JNI_OnLoad(JavaVM* vm, void*) {
+  return facebook::jni::initialize(vm, [] {});
+}
+
+#endif
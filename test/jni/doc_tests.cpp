@@ -29,6 +29,10 @@ using namespace facebook::jni;
 #include <fbjni/ByteBuffer.h>
 // END
 
+// SECTION command_queue
+#include <fbjni/CommandQueue.h>
+// END
+
 // We can put all of our code in an anonymous namespace if
 // it is not used from any other C++ code.
 namespace {
@@ -440,6 +444,32 @@ struct DocTests : JavaClass<DocTests> {
   }
   // END
 
+  // SECTION command_queue
+  static double commandTotal;
+
+  static local_ref<JCommandQueue::jhybridobject> createCommandQueue(
+      alias_ref<JClass> clazz) {
+    auto queue = JCommandQueue::create(4096);
+    // Handlers receive the command's arguments in the order Java wrote them.
+    queue->cthis()->on<jint, jdouble>(0, [](jint count, jdouble scale) {
+      commandTotal += count * scale;
+    });
+    return queue;
+  }
+  /* MARKDOWN
+  Every native method call pays a fixed entry cost, C: the JNI transition,
+  setting up the JNIEnv, and the try/catch that translates C++ exceptions.
+  Flushing N commands together costs about C + N × d, where d is the cost of
+  writing one command's arguments and dispatching it to its handler, so each
+  command costs about C / N + d. Measure C and d on your target devices to
+  decide whether it is worth batching a particular call.
+  // END
+  */
+
+  static double commandQueueTotal(alias_ref<JClass> clazz) {
+    return commandTotal;
+  }
+
  public:
   // SECTION registration
   // NOTE: The name of this method doesn't matter.
@@ -463,10 +493,14 @@ struct DocTests : JavaClass<DocTests> {
         makeNativeMethod("concatMatches", DocTests::concatMatches),
         makeNativeMethod("buildCollections", DocTests::buildCollections),
         makeNativeMethod("transformBuffer", DocTests::transformBuffer),
+        makeNativeMethod("createCommandQueue", DocTests::createCommandQueue),
+        makeNativeMethod("commandQueueTotal", DocTests::commandQueueTotal),
     });
   }
 };
 
+double DocTests::commandTotal = 0;
+
 } // Anonymous namespace
 
 // SECTION registration
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fbjni/DynamicMethodCache.h>
+#include <fbjni/fbjni.h>
+
+#include "expect.h"
+#include "jni_call_counter.h"
+
+using namespace facebook::jni;
+using facebook::jni::test::JniCallCounter;
+
+namespace {
+
+constexpr auto kGreetDescriptor = "(Ljava/lang/String;I)Ljava/lang/String;";
+
+struct Greeter : JavaClass<Greeter> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/jni/DynamicMethodCacheTests$Greeter;";
+};
+
+struct LoudGreeter : JavaClass<LoudGreeter, Greeter> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/jni/DynamicMethodCacheTests$LoudGreeter;";
+};
+
+std::string greet(
+    const DynamicMethod& method,
+    alias_ref<jobject> greeter,
+    const char* name,
+    jint times) {
+  auto str = make_jstring(name);
+  jvalue args[2];
+  args[0].l = str.get();
+  args[1].i = times;
+  auto result = method.invoke(greeter, args);
+  return adopt_local(static_cast<jstring>(result.l))->toStdString();
+}
+
+jboolean nativeTestInvoke(alias_ref<jclass>, alias_ref<jobject> greeter) {
+  DynamicMethodCache cache;
+
+  auto& greetMethod =
+      cache.getMethod(Greeter::javaClassStatic(), "greet", kGreetDescriptor);
+  EXPECT(!greetMethod.isStatic());
+  EXPECT(greetMethod.returnType() == 'L');
+  EXPECT(greet(greetMethod, greeter, "world", 2) ==
+         "hello world;hello world;");
+
+  auto& addMethod =
+      cache.getStaticMethod(Greeter::javaClassStatic(), "add", "(JJ)J");
+  EXPECT(addMethod.isStatic());
+  EXPECT(addMethod.returnType() == 'J');
+  jvalue args[2];
+  args[0].j = 40;
+  args[1].j = 2;
+  EXPECT(addMethod.invoke(nullptr, args).j == 42);
+
+  return JNI_TRUE;
+}
+
+jboolean nativeTestHitsSkipResolution(
+    alias_ref<jclass>,
+    alias_ref<jobject> greeter) {
+  DynamicMethodCache cache;
+  auto cls = Greeter::javaClassStatic();
+  auto& first = cache.getMethod(cls, "greet", kGreetDescriptor);
+
+  JniCallCounter counter;
+  for (int i = 0; i < 10; ++i) {
+    EXPECT(&cache.getMethod(cls, "greet", kGreetDescriptor) == &first);
+  }
+  EXPECT_JNI_CALLS_LE(counter, GetMethodID, 0);
+  EXPECT_JNI_CALLS_LE(counter, IsSameObject, 10);
+
+  // The same name and descriptor on another class, or as a static method,
+  // is a different method.
+  EXPECT(
+      &cache.getMethod(
+          LoudGreeter::javaClassStatic(), "greet", kGreetDescriptor) != &first);
+
+  auto stats = cache.stats();
+  EXPECT(stats.hits == 10);
+  EXPECT(stats.misses == 2);
+  EXPECT(stats.callSiteHits == 0);
+
+  cache.resetStats();
+  EXPECT(cache.stats().hits == 0);
+  EXPECT(cache.stats().resolveTime.count() == 0);
+
+  EXPECT(greet(first, greeter, "again", 1) == "hello again;");
+  return JNI_TRUE;
+}
+
+jboolean nativeTestCallSite(
+    alias_ref<jclass>,
+    alias_ref<jobject> greeter,
+    alias_ref<jobject> loud) {
+  DynamicMethodCache cache;
+  DynamicMethodCache::CallSite site(cache, "greet", kGreetDescriptor);
+
+  auto greeterClass = greeter->getClass();
+  auto loudClass = loud->getClass();
+  for (int i = 0; i < 3; ++i) {
+    EXPECT(greet(site.lookup(greeterClass), greeter, "a", 1) == "hello a;");
+  }
+  EXPECT(greet(site.lookup(loudClass), loud, "b", 1) == "HELLO B;");
+  EXPECT(greet(site.lookup(greeterClass), greeter, "c", 1) == "hello c;");
+
+  // The first lookup of each class misses the call site and the map. Going
+  // back to the first class misses the call site but hits the map.
+  auto stats = cache.stats();
+  EXPECT(stats.misses == 2);
+  EXPECT(stats.callSiteHits == 2);
+  EXPECT(stats.hits == 3);
+
+  return JNI_TRUE;
+}
+
+void nativeTestMissingMethod(alias_ref<jclass>) {
+  DynamicMethodCache cache;
+  cache.getMethod(Greeter::javaClassStatic(), "missing", "()V");
+}
+
+} // namespace
+
+void RegisterDynamicMethodCacheTests() {
+  registerNatives(
+      "com/facebook/jni/DynamicMethodCacheTests",
+      {
+          makeNativeMethod("nativeTestInvoke", nativeTestInvoke),
+          makeNativeMethod(
+              "nativeTestHitsSkipResolution", nativeTestHitsSkipResolution),
+          makeNativeMethod("nativeTestCallSite", nativeTestCallSite),
+          makeNativeMethod("nativeTestMissingMethod", nativeTestMissingMethod),
+      });
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "embedded_jvm.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include <fbjni/fbjni.h>
+
+namespace facebook {
+namespace jni {
+namespace test {
+
+namespace {
+
+struct JNativeLoaderDelegate : JavaClass<JNativeLoaderDelegate> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/soloader/nativeloader/NativeLoaderDelegate;";
+};
+
+struct JSystemDelegate : JavaClass<JSystemDelegate, JNativeLoaderDelegate> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/soloader/nativeloader/SystemDelegate;";
+
+  static local_ref<javaobject> create() {
+    return newInstance();
+  }
+};
+
+struct JNativeLoader : JavaClass<JNativeLoader> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/soloader/nativeloader/NativeLoader;";
+
+  static void loadLibrary(const std::string& name) {
+    auto cls = javaClassStatic();
+    static const auto isInitialized =
+        cls->getStaticMethod<jboolean()>("isInitialized");
+    static const auto init =
+        cls->getStaticMethod<void(alias_ref<JNativeLoaderDelegate>)>("init");
+    static const auto load =
+        cls->getStaticMethod<jboolean(std::string)>("loadLibrary");
+    if (!isInitialized(cls)) {
+      init(cls, JSystemDelegate::create());
+    }
+    load(cls, name);
+  }
+};
+
+std::string fromEnvironment(const char* name, const char* fallback) {
+  const char* value = std::getenv(name);
+  return value ? value : fallback;
+}
+
+} // namespace
+
+EmbeddedJvmOptions defaultEmbeddedJvmOptions() {
+  EmbeddedJvmOptions options;
+  options.classPath =
+      fromEnvironment("FBJNI_EMBEDDED_CLASSPATH", FBJNI_EMBEDDED_CLASSPATH);
+  options.libraryPath = fromEnvironment(
+      "FBJNI_EMBEDDED_LIBRARY_PATH", FBJNI_EMBEDDED_LIBRARY_PATH);
+  return options;
+}
+
+JavaVM* createEmbeddedJvm(const EmbeddedJvmOptions& options) {
+  std::vector<std::string> strings{
+      "-Djava.class.path=" + options.classPath,
+      "-Djava.library.path=" + options.libraryPath,
+  };
+  strings.insert(
+      strings.end(), options.jvmOptions.begin(), options.jvmOptions.end());
+  std::vector<JavaVMOption> jvmOptions(strings.size());
+  for (size_t i = 0; i < strings.size(); ++i) {
+    jvmOptions[i].optionString = const_cast<char*>(strings[i].c_str());
+    jvmOptions[i].extraInfo = nullptr;
+  }
+
+  JavaVMInitArgs args;
+  args.version = JNI_VERSION_1_6;
+  args.nOptions = static_cast<jint>(jvmOptions.size());
+  args.options = jvmOptions.data();
+  args.ignoreUnrecognized = JNI_FALSE;
+
+  JavaVM* vm = nullptr;
+  JNIEnv* env = nullptr;
+  jint result = JNI_CreateJavaVM(&vm, reinterpret_cast<void**>(&env), &args);
+  if (result != JNI_OK) {
+    throw std::runtime_error(
+        "JNI_CreateJavaVM failed with error " + std::to_string(result));
+  }
+
+  // Repeated calls are harmless, so libfbjni's own JNI_OnLoad can call it
+  // again when it is loaded below. A static fbjni is linked into this binary
+  // instead, and only has its natives registered if we do it.
+#ifdef FBJNI_STATIC
+  initialize(vm, [] { registerFbjniNatives(); });
+#else
+  initialize(vm, [] {});
+#endif
+  try {
+    for (const auto& library : options.libraries) {
+      JNativeLoader::loadLibrary(library);
+    }
+  } catch (const JniException& ex) {
+    throw std::runtime_error(
+        std::string("Failed to load libraries in the embedded JVM: ") +
+        ex.what());
+  }
+  return vm;
+}
+
+} // namespace test
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include <string>
+#include <vector>
+
+namespace facebook {
+namespace jni {
+namespace test {
+
+/**
+ * Runs C++ tests and benchmarks against a JVM created in this process, so
+ * that they can be built and run with ctest alone instead of from a Java test
+ * runner.
+ */
+struct EmbeddedJvmOptions {
+  // Must contain the fbjni Java classes and soloader's nativeloader.
+  std::string classPath;
+  // Where System.loadLibrary looks for libfbjni and any test libraries.
+  std::string libraryPath;
+  // Loaded in order through NativeLoader, as BaseFBJniTests does, so that
+  // each library's JNI_OnLoad runs as it would in an app.
+  std::vector<std::string> libraries{"fbjni"};
+  // Any other options for the JVM, e.g. "-Xcheck:jni".
+  std::vector<std::string> jvmOptions;
+};
+
+/**
+ * The options the harness was built with. The FBJNI_EMBEDDED_CLASSPATH and
+ * FBJNI_EMBEDDED_LIBRARY_PATH environment variables override the classpath
+ * and library path.
+ */
+EmbeddedJvmOptions defaultEmbeddedJvmOptions();
+
+/**
+ * Creates the JVM, initializes fbjni with it and loads the libraries. The
+ * calling thread is left attached. There can only be one JVM per process,
+ * so this may only be called once. Throws std::runtime_error on failure.
+ */
+JavaVM* createEmbeddedJvm(const EmbeddedJvmOptions& options);
+
+} // namespace test
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <fbjni/NativeRunnable.h>
+#include <fbjni/fbjni.h>
+
+using namespace facebook::jni;
+
+TEST(EmbeddedJvm, StringRoundTrip) {
+  auto str = make_jstring("hello \xf0\x9f\x98\x80");
+  EXPECT_EQ("hello \xf0\x9f\x98\x80", str->toStdString());
+}
+
+TEST(EmbeddedJvm, FindsClasses) {
+  auto cls = findClassLocal("java/lang/String");
+  EXPECT_TRUE(cls->isAssignableFrom(JString::javaClassLocal()));
+}
+
+TEST(EmbeddedJvm, JavaExceptionsBecomeJniExceptions) {
+  auto cls = findClassLocal("java/lang/Integer");
+  auto parseInt = cls->getStaticMethod<jint(std::string)>("parseInt");
+  EXPECT_EQ(42, parseInt(cls, "42"));
+  EXPECT_THROW(parseInt(cls, "forty-two"), JniException);
+}
+
+// Hybrid objects only work if libfbjni's JNI_OnLoad ran and registered the
+// natives for HybridData.
+TEST(EmbeddedJvm, RunsHybridRunnable) {
+  std::atomic<int> runs{0};
+  auto runnable = JNativeRunnable::newObjectCxxArgs([&] { ++runs; });
+  static const auto run =
+      JRunnable::javaClassStatic()->getMethod<void()>("run");
+  run(runnable);
+  EXPECT_EQ(1, runs.load());
+}
+
+TEST(EmbeddedJvm, AttachesOtherThreads) {
+  std::string value;
+  std::thread thread([&] {
+    ThreadScope::WithClassLoader([&] {
+      value = make_jstring("from another thread")->toStdString();
+    });
+  });
+  thread.join();
+  EXPECT_EQ("from another thread", value);
+}
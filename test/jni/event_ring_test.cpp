@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fbjni/EventRing.h>
+
+using namespace facebook::jni;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Reads records the way com.facebook.jni.EventRing does.
+class Consumer {
+ public:
+  explicit Consumer(EventRing& ring) : ring_(ring) {}
+
+  // Returns false once the ring is closed and drained.
+  bool drain(
+      std::vector<std::string>& records,
+      std::chrono::milliseconds timeout = 1000ms) {
+    int64_t available = ring_.awaitBatch(consumed_, timeout);
+    consumed_ = 0;
+    if (available < 0) {
+      return false;
+    }
+    while (consumed_ < static_cast<size_t>(available)) {
+      int32_t length;
+      std::memcpy(&length, ring_.data() + offset_, sizeof(length));
+      size_t size;
+      if (length == EventRing::kPadding) {
+        size = ring_.capacity() - offset_;
+      } else {
+        records.emplace_back(
+            reinterpret_cast<const char*>(ring_.data()) + offset_ +
+                EventRing::kHeaderSize,
+            length);
+        size = (EventRing::kHeaderSize + length + EventRing::kAlignment - 1) &
+            ~(EventRing::kAlignment - 1);
+      }
+      consumed_ += size;
+      offset_ = (offset_ + size) & (ring_.capacity() - 1);
+    }
+    return true;
+  }
+
+ private:
+  EventRing& ring_;
+  size_t offset_ = 0;
+  size_t consumed_ = 0;
+};
+
+bool write(EventRing& ring, const std::string& record) {
+  return ring.tryWrite(record.data(), record.size());
+}
+
+} // namespace
+
+TEST(EventRing_test, roundsCapacityUpToPowerOfTwo) {
+  EXPECT_EQ(EventRing(100).capacity(), 128u);
+  EXPECT_EQ(EventRing(1024).capacity(), 1024u);
+  EXPECT_THROW(EventRing(EventRing::kMaxCapacity + 1), std::invalid_argument);
+}
+
+TEST(EventRing_test, deliversRecordsInOrder) {
+  EventRing ring(256);
+  Consumer consumer(ring);
+  EXPECT_TRUE(write(ring, "a"));
+  EXPECT_TRUE(write(ring, ""));
+  EXPECT_TRUE(write(ring, "hello"));
+  std::vector<std::string> records;
+  EXPECT_TRUE(consumer.drain(records));
+  EXPECT_EQ(records, (std::vector<std::string>{"a", "", "hello"}));
+}
+
+TEST(EventRing_test, timesOutWhenEmpty) {
+  EventRing ring(256);
+  Consumer consumer(ring);
+  std::vector<std::string> records;
+  EXPECT_TRUE(consumer.drain(records, 10ms));
+  EXPECT_TRUE(records.empty());
+}
+
+TEST(EventRing_test, dropsWhenFull) {
+  EventRing ring(64);
+  Consumer consumer(ring);
+  std::string record(12, 'x');
+  // Each record takes 16 bytes.
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(write(ring, record));
+  }
+  EXPECT_FALSE(write(ring, record));
+  EXPECT_EQ(ring.droppedCount(), 1u);
+  // Too large to ever fit.
+  EXPECT_FALSE(write(ring, std::string(40, 'x')));
+  EXPECT_EQ(ring.droppedCount(), 2u);
+
+  std::vector<std::string> records;
+  EXPECT_TRUE(consumer.drain(records));
+  EXPECT_EQ(records.size(), 4u);
+  // The space is freed by the next drain.
+  EXPECT_TRUE(consumer.drain(records, 0ms));
+  EXPECT_TRUE(write(ring, record));
+}
+
+TEST(EventRing_test, padsRecordsAtTheEnd) {
+  EventRing ring(64);
+  Consumer consumer(ring);
+  std::vector<std::string> records;
+  for (int i = 0; i < 20; ++i) {
+    // 24 bytes per record, which doesn't divide the capacity.
+    std::string record = std::to_string(i) + std::string(18, 'x');
+    record.resize(20, 'y');
+    EXPECT_TRUE(write(ring, record));
+    EXPECT_TRUE(consumer.drain(records));
+    ASSERT_EQ(records.size(), static_cast<size_t>(i + 1));
+    EXPECT_EQ(records.back(), record);
+  }
+}
+
+TEST(EventRing_test, closeWakesConsumer) {
+  EventRing ring(256);
+  Consumer consumer(ring);
+  write(ring, "last");
+  std::thread closer([&] {
+    std::this_thread::sleep_for(10ms);
+    ring.close();
+  });
+  std::vector<std::string> records;
+  EXPECT_TRUE(consumer.drain(records));
+  EXPECT_FALSE(consumer.drain(records, 10000ms));
+  EXPECT_EQ(records, std::vector<std::string>{"last"});
+  EXPECT_FALSE(write(ring, "late"));
+  closer.join();
+}
+
+TEST(EventRing_test, multipleProducers) {
+  constexpr int kProducers = 4;
+  constexpr int kRecords = 20000;
+  EventRing ring(4096);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&ring, p] {
+      for (int i = 0; i < kRecords; ++i) {
+        std::string record = std::to_string(p) + ":" + std::to_string(i);
+        while (!write(ring, record)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::thread closer([&] {
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    ring.close();
+  });
+
+  Consumer consumer(ring);
+  std::vector<std::string> records;
+  while (consumer.drain(records)) {
+  }
+  closer.join();
+
+  ASSERT_EQ(records.size(), static_cast<size_t>(kProducers * kRecords));
+  // Each producer's records arrive in the order it wrote them.
+  std::vector<int> next(kProducers, 0);
+  for (const auto& record : records) {
+    auto colon = record.find(':');
+    int p = std::stoi(record.substr(0, colon));
+    int i = std::stoi(record.substr(colon + 1));
+    EXPECT_EQ(i, next[p]);
+    next[p] = i + 1;
+  }
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
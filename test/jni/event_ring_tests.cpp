@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <fbjni/EventRing.h>
+#include <fbjni/fbjni.h>
+
+using namespace facebook::jni;
+
+namespace {
+
+// Runs body(thread) on threadCount threads, and returns once they have all
+// finished.
+template <typename F>
+void runOnThreads(jint threadCount, F body) {
+  std::vector<std::thread> threads;
+  for (jint i = 0; i < threadCount; ++i) {
+    threads.emplace_back([&body, i] { body(i); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+local_ref<JEventRing::javaobject> nativeCreateRing(
+    alias_ref<jclass>,
+    jint capacity) {
+  return JEventRing::create(std::make_shared<EventRing>(capacity));
+}
+
+// Each thread writes events numbered from 0 to eventsPerThread - 1, waiting
+// for space if the ring is full, and the ring is closed once all are written.
+void nativeProduce(
+    alias_ref<jclass>,
+    JEventRing* ring,
+    jint threadCount,
+    jint eventsPerThread) {
+  std::shared_ptr<EventRing> events = ring->ring();
+  runOnThreads(threadCount, [&](jint) {
+    for (jlong i = 0; i < eventsPerThread; ++i) {
+      while (!events->tryWrite(&i, sizeof(i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  events->close();
+}
+
+void RegisterEventRingTests() {
+  registerNatives(
+      "com/facebook/jni/EventRingTests",
+      {
+          makeNativeMethod("nativeCreateRing", nativeCreateRing),
+          makeNativeMethod("nativeProduce", nativeProduce),
+      });
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <fbjni/Executor.h>
+#include <fbjni/fbjni.h>
+
+using namespace facebook::jni;
+
+namespace {
+
+// Totals for the tasks run since the last call to nativeAwaitTasks.
+std::mutex tasksMutex;
+std::condition_variable tasksDone;
+jint tasksRun = 0;
+jlong tasksSum = 0;
+
+std::function<void()> makeTask(jint value) {
+  return [value] {
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    ++tasksRun;
+    tasksSum += value;
+    tasksDone.notify_all();
+  };
+}
+
+} // namespace
+
+void nativeSubmitBatch(
+    alias_ref<jclass>,
+    alias_ref<JExecutor> executor,
+    jint count) {
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(count);
+  for (jint i = 0; i < count; ++i) {
+    tasks.push_back(makeTask(i));
+  }
+  executor->submitBatch(std::move(tasks));
+}
+
+void nativeSubmitEach(
+    alias_ref<jclass>,
+    alias_ref<JExecutor> executor,
+    jint count) {
+  for (jint i = 0; i < count; ++i) {
+    executor->execute(makeTask(i));
+  }
+}
+
+void nativeSubmitThrowing(alias_ref<jclass>, alias_ref<JExecutor> executor) {
+  std::vector<std::function<void()>> tasks;
+  tasks.push_back([] { throw std::runtime_error("task failed"); });
+  executor->submitBatch(std::move(tasks));
+}
+
+// Submits count tasks that share a capture, and returns how many of the tasks
+// still hold it once submitBatch has thrown.
+jint nativeSubmitRejected(
+    alias_ref<jclass>,
+    alias_ref<JExecutor> executor,
+    jint count) {
+  auto capture = std::make_shared<int>(0);
+  std::vector<std::function<void()>> tasks;
+  for (jint i = 0; i < count; ++i) {
+    tasks.push_back([capture] {});
+  }
+  try {
+    executor->submitBatch(std::move(tasks));
+  } catch (const JniException&) {
+    return static_cast<jint>(capture.use_count() - 1);
+  }
+  return -1;
+}
+
+// Waits for count tasks to have run, then returns the sum of their values.
+jlong nativeAwaitTasks(alias_ref<jclass>, jint count) {
+  std::unique_lock<std::mutex> lock(tasksMutex);
+  tasksDone.wait(lock, [count] { return tasksRun >= count; });
+  jlong sum = tasksSum;
+  tasksRun = 0;
+  tasksSum = 0;
+  return sum;
+}
+
+void RegisterExecutorTests() {
+  registerNatives(
+      "com/facebook/jni/ExecutorTests",
+      {
+          makeNativeMethod("nativeSubmitBatch", nativeSubmitBatch),
+          makeNativeMethod("nativeSubmitEach", nativeSubmitEach),
+          makeNativeMethod("nativeSubmitThrowing", nativeSubmitThrowing),
+          makeNativeMethod("nativeSubmitRejected", nativeSubmitRejected),
+          makeNativeMethod("nativeAwaitTasks", nativeAwaitTasks),
+      });
+}
@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fake_jni.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fbjni/fbjni.h>
+
+namespace facebook {
+namespace jni {
+namespace test {
+
+namespace {
+
+using EnvTable = std::remove_const_t<
+    std::remove_pointer_t<decltype(std::declval<JNIEnv>().functions)>>;
+using VmTable = std::remove_const_t<
+    std::remove_pointer_t<decltype(std::declval<JavaVM>().functions)>>;
+
+std::array<std::atomic<size_t>, kJniFunctionCount> callCounts{};
+
+void count(JniFunction function) {
+  callCounts[static_cast<size_t>(function)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+struct FakeObject {
+  std::u16string chars;
+  std::vector<jint> ints;
+};
+
+// What a jobject points to. Each reference gets its own handle, so deleting
+// one doesn't affect others to the same object.
+struct Handle {
+  std::shared_ptr<FakeObject> object;
+  jobjectRefType type;
+};
+
+Handle* handle(jobject ref) {
+  return reinterpret_cast<Handle*>(ref);
+}
+
+std::shared_ptr<FakeObject> objectOf(jobject ref) {
+  return ref ? handle(ref)->object : nullptr;
+}
+
+// The local reference frames of the calling thread. The first one stands in
+// for the frame of the native method the thread would be running.
+thread_local std::vector<std::vector<Handle*>> localFrames(1);
+thread_local bool attached = false;
+thread_local jthrowable pendingException = nullptr;
+std::atomic<size_t> liveGlobalRefs{0};
+
+JNIEnv fakeEnv;
+JavaVM fakeVm;
+
+jobject newLocal(std::shared_ptr<FakeObject> object) {
+  if (!object) {
+    return nullptr;
+  }
+  auto ref = new Handle{std::move(object), JNILocalRefType};
+  localFrames.back().push_back(ref);
+  return reinterpret_cast<jobject>(ref);
+}
+
+jobject newGlobal(jobject ref, jobjectRefType type) {
+  if (!ref) {
+    return nullptr;
+  }
+  liveGlobalRefs.fetch_add(1, std::memory_order_relaxed);
+  return reinterpret_cast<jobject>(new Handle{objectOf(ref), type});
+}
+
+void deleteGlobal(jobject ref) {
+  if (ref) {
+    liveGlobalRefs.fetch_sub(1, std::memory_order_relaxed);
+    delete handle(ref);
+  }
+}
+
+// Fake methods and fields all share one ID; nothing looks inside them.
+template <typename ID>
+ID fakeId() {
+  static char id;
+  return reinterpret_cast<ID>(&id);
+}
+
+template <size_t Slot>
+void unimplemented() {
+  fprintf(
+      stderr,
+      "fbjni fake JNI: function in slot %zu is not implemented\n",
+      Slot);
+  abort();
+}
+
+template <typename Table, size_t... Slots>
+void fillWithUnimplemented(Table& table, std::index_sequence<Slots...>) {
+  auto slots = reinterpret_cast<void**>(&table);
+  using Fn = void (*)();
+  Fn fns[] = {&unimplemented<Slots>...};
+  for (size_t i = 0; i < sizeof...(Slots); ++i) {
+    slots[i] = reinterpret_cast<void*>(fns[i]);
+  }
+}
+
+template <typename Table>
+void fillWithUnimplemented(Table& table) {
+  fillWithUnimplemented(
+      table, std::make_index_sequence<sizeof(Table) / sizeof(void*)>());
+}
+
+// JavaVM
+
+jint JNICALL DestroyJavaVM(JavaVM*) {
+  count(JniFunction::DestroyJavaVM);
+  return JNI_ERR;
+}
+
+// The env parameter is void** in some jni.h and JNIEnv** in others.
+template <typename EnvOut>
+jint JNICALL AttachCurrentThread(JavaVM*, EnvOut* env, void*) {
+  count(JniFunction::AttachCurrentThread);
+  attached = true;
+  *env = reinterpret_cast<EnvOut>(&fakeEnv);
+  return JNI_OK;
+}
+
+jint JNICALL DetachCurrentThread(JavaVM*) {
+  count(JniFunction::DetachCurrentThread);
+  attached = false;
+  return JNI_OK;
+}
+
+jint JNICALL GetEnv(JavaVM*, void** env, jint) {
+  count(JniFunction::GetEnv);
+  if (!attached) {
+    *env = nullptr;
+    return JNI_EDETACHED;
+  }
+  *env = &fakeEnv;
+  return JNI_OK;
+}
+
+template <typename EnvOut>
+jint JNICALL AttachCurrentThreadAsDaemon(JavaVM*, EnvOut* env, void*) {
+  count(JniFunction::AttachCurrentThreadAsDaemon);
+  attached = true;
+  *env = reinterpret_cast<EnvOut>(&fakeEnv);
+  return JNI_OK;
+}
+
+// JNIEnv
+
+jint JNICALL GetVersion(JNIEnv*) {
+  count(JniFunction::GetVersion);
+  return JNI_VERSION_1_6;
+}
+
+jclass JNICALL FindClass(JNIEnv*, const char*) {
+  count(JniFunction::FindClass);
+  return static_cast<jclass>(newLocal(std::make_shared<FakeObject>()));
+}
+
+jclass JNICALL GetSuperclass(JNIEnv*, jclass) {
+  count(JniFunction::GetSuperclass);
+  return nullptr;
+}
+
+jboolean JNICALL IsAssignableFrom(JNIEnv*, jclass, jclass) {
+  count(JniFunction::IsAssignableFrom);
+  return JNI_TRUE;
+}
+
+jint JNICALL Throw(JNIEnv*, jthrowable throwable) {
+  count(JniFunction::Throw);
+  if (pendingException) {
+    deleteGlobal(pendingException);
+  }
+  pendingException =
+      static_cast<jthrowable>(newGlobal(throwable, JNIGlobalRefType));
+  return JNI_OK;
+}
+
+jthrowable JNICALL ExceptionOccurred(JNIEnv*) {
+  count(JniFunction::ExceptionOccurred);
+  return static_cast<jthrowable>(newLocal(objectOf(pendingException)));
+}
+
+void JNICALL ExceptionClear(JNIEnv*) {
+  count(JniFunction::ExceptionClear);
+  deleteGlobal(pendingException);
+  pendingException = nullptr;
+}
+
+jint JNICALL PushLocalFrame(JNIEnv*, jint) {
+  count(JniFunction::PushLocalFrame);
+  localFrames.emplace_back();
+  return JNI_OK;
+}
+
+jobject JNICALL PopLocalFrame(JNIEnv*, jobject result) {
+  count(JniFunction::PopLocalFrame);
+  auto object = objectOf(result);
+  for (auto ref : localFrames.back()) {
+    delete ref;
+  }
+  localFrames.pop_back();
+  return newLocal(std::move(object));
+}
+
+jobject JNICALL NewGlobalRef(JNIEnv*, jobject ref) {
+  count(JniFunction::NewGlobalRef);
+  return newGlobal(ref, JNIGlobalRefType);
+}
+
+void JNICALL DeleteGlobalRef(JNIEnv*, jobject ref) {
+  count(JniFunction::DeleteGlobalRef);
+  deleteGlobal(ref);
+}
+
+void JNICALL DeleteLocalRef(JNIEnv*, jobject ref) {
+  count(JniFunction::DeleteLocalRef);
+  if (!ref) {
+    return;
+  }
+  for (auto frame = localFrames.rbegin(); frame != localFrames.rend();
+       ++frame) {
+    auto it = std::find(frame->rbegin(), frame->rend(), handle(ref));
+    if (it != frame->rend()) {
+      frame->erase(std::next(it).base());
+      delete handle(ref);
+      return;
+    }
+  }
+  fprintf(stderr, "fbjni fake JNI: deleting an unknown local reference\n");
+  abort();
+}
+
+jboolean JNICALL IsSameObject(JNIEnv*, jobject a, jobject b) {
+  count(JniFunction::IsSameObject);
+  return objectOf(a) == objectOf(b) ? JNI_TRUE : JNI_FALSE;
+}
+
+jobject JNICALL NewLocalRef(JNIEnv*, jobject ref) {
+  count(JniFunction::NewLocalRef);
+  return newLocal(objectOf(ref));
+}
+
+jint JNICALL EnsureLocalCapacity(JNIEnv*, jint) {
+  count(JniFunction::EnsureLocalCapacity);
+  return JNI_OK;
+}
+
+jobject JNICALL NewObjectV(JNIEnv*, jclass, jmethodID, va_list) {
+  count(JniFunction::NewObjectV);
+  return newLocal(std::make_shared<FakeObject>());
+}
+
+jclass JNICALL GetObjectClass(JNIEnv*, jobject) {
+  count(JniFunction::GetObjectClass);
+  return static_cast<jclass>(newLocal(std::make_shared<FakeObject>()));
+}
+
+jboolean JNICALL IsInstanceOf(JNIEnv*, jobject, jclass) {
+  count(JniFunction::IsInstanceOf);
+  return JNI_TRUE;
+}
+
+jmethodID JNICALL GetMethodID(JNIEnv*, jclass, const char*, const char*) {
+  count(JniFunction::GetMethodID);
+  return fakeId<jmethodID>();
+}
+
+jobject JNICALL CallObjectMethodV(JNIEnv*, jobject, jmethodID, va_list) {
+  count(JniFunction::CallObjectMethodV);
+  return nullptr;
+}
+
+jboolean JNICALL CallBooleanMethodV(JNIEnv*, jobject, jmethodID, va_list) {
+  count(JniFunction::CallBooleanMethodV);
+  return JNI_FALSE;
+}
+
+jint JNICALL CallIntMethodV(JNIEnv*, jobject, jmethodID, va_list) {
+  count(JniFunction::CallIntMethodV);
+  return 0;
+}
+
+jlong JNICALL CallLongMethodV(JNIEnv*, jobject, jmethodID, va_list) {
+  count(JniFunction::CallLongMethodV);
+  return 0;
+}
+
+void JNICALL CallVoidMethodV(JNIEnv*, jobject, jmethodID, va_list) {
+  count(JniFunction::CallVoidMethodV);
+}
+
+jfieldID JNICALL GetFieldID(JNIEnv*, jclass, const char*, const char*) {
+  count(JniFunction::GetFieldID);
+  return fakeId<jfieldID>();
+}
+
+jobject JNICALL GetObjectField(JNIEnv*, jobject, jfieldID) {
+  count(JniFunction::GetObjectField);
+  return nullptr;
+}
+
+jint JNICALL GetIntField(JNIEnv*, jobject, jfieldID) {
+  count(JniFunction::GetIntField);
+  return 0;
+}
+
+void JNICALL SetIntField(JNIEnv*, jobject, jfieldID, jint) {
+  count(JniFunction::SetIntField);
+}
+
+jmethodID JNICALL
+GetStaticMethodID(JNIEnv*, jclass, const char*, const char*) {
+  count(JniFunction::GetStaticMethodID);
+  return fakeId<jmethodID>();
+}
+
+jobject JNICALL CallStaticObjectMethodV(JNIEnv*, jclass, jmethodID, va_list) {
+  count(JniFunction::CallStaticObjectMethodV);
+  return nullptr;
+}
+
+jint JNICALL CallStaticIntMethodV(JNIEnv*, jclass, jmethodID, va_list) {
+  count(JniFunction::CallStaticIntMethodV);
+  return 0;
+}
+
+void JNICALL CallStaticVoidMethodV(JNIEnv*, jclass, jmethodID, va_list) {
+  count(JniFunction::CallStaticVoidMethodV);
+}
+
+jfieldID JNICALL GetStaticFieldID(JNIEnv*, jclass, const char*, const char*) {
+  count(JniFunction::GetStaticFieldID);
+  return fakeId<jfieldID>();
+}
+
+jstring JNICALL NewString(JNIEnv*, const jchar* chars, jsize length) {
+  count(JniFunction::NewString);
+  auto object = std::make_shared<FakeObject>();
+  object->chars.assign(chars, chars + length);
+  return static_cast<jstring>(newLocal(std::move(object)));
+}
+
+jsize JNICALL GetStringLength(JNIEnv*, jstring str) {
+  count(JniFunction::GetStringLength);
+  return static_cast<jsize>(objectOf(str)->chars.size());
+}
+
+// Only correct for ASCII, which is all the fake needs.
+jstring JNICALL NewStringUTF(JNIEnv*, const char* utf) {
+  count(JniFunction::NewStringUTF);
+  auto object = std::make_shared<FakeObject>();
+  for (; *utf; ++utf) {
+    object->chars.push_back(static_cast<unsigned char>(*utf));
+  }
+  return static_cast<jstring>(newLocal(std::move(object)));
+}
+
+jsize JNICALL GetArrayLength(JNIEnv*, jarray array) {
+  count(JniFunction::GetArrayLength);
+  return static_cast<jsize>(objectOf(array)->ints.size());
+}
+
+jintArray JNICALL NewIntArray(JNIEnv*, jsize length) {
+  count(JniFunction::NewIntArray);
+  auto object = std::make_shared<FakeObject>();
+  object->ints.resize(length);
+  return static_cast<jintArray>(newLocal(std::move(object)));
+}
+
+void JNICALL
+GetIntArrayRegion(JNIEnv*, jintArray array, jsize start, jsize len, jint* buf) {
+  count(JniFunction::GetIntArrayRegion);
+  auto& ints = objectOf(array)->ints;
+  std::copy(ints.begin() + start, ints.begin() + start + len, buf);
+}
+
+void JNICALL SetIntArrayRegion(
+    JNIEnv*,
+    jintArray array,
+    jsize start,
+    jsize len,
+    const jint* buf) {
+  count(JniFunction::SetIntArrayRegion);
+  std::copy(buf, buf + len, objectOf(array)->ints.begin() + start);
+}
+
+jint JNICALL RegisterNatives(JNIEnv*, jclass, const JNINativeMethod*, jint) {
+  count(JniFunction::RegisterNatives);
+  return JNI_OK;
+}
+
+const jchar* JNICALL GetStringCritical(JNIEnv*, jstring str, jboolean* copy) {
+  count(JniFunction::GetStringCritical);
+  if (copy) {
+    *copy = JNI_FALSE;
+  }
+  return reinterpret_cast<const jchar*>(objectOf(str)->chars.data());
+}
+
+void JNICALL ReleaseStringCritical(JNIEnv*, jstring, const jchar*) {
+  count(JniFunction::ReleaseStringCritical);
+}
+
+jweak JNICALL NewWeakGlobalRef(JNIEnv*, jobject ref) {
+  count(JniFunction::NewWeakGlobalRef);
+  return newGlobal(ref, JNIWeakGlobalRefType);
+}
+
+void JNICALL DeleteWeakGlobalRef(JNIEnv*, jweak ref) {
+  count(JniFunction::DeleteWeakGlobalRef);
+  deleteGlobal(ref);
+}
+
+jboolean JNICALL ExceptionCheck(JNIEnv*) {
+  count(JniFunction::ExceptionCheck);
+  return pendingException ? JNI_TRUE : JNI_FALSE;
+}
+
+jobjectRefType JNICALL GetObjectRefType(JNIEnv*, jobject ref) {
+  count(JniFunction::GetObjectRefType);
+  return ref ? handle(ref)->type : JNIInvalidRefType;
+}
+
+} // namespace
+
+FakeJni::FakeJni() {
+  static VmTable vmTable;
+  fillWithUnimplemented(vmTable);
+  static EnvTable envTable;
+  fillWithUnimplemented(envTable);
+#define FBJNI_FAKE_JNI_INSTALL_VM(name) vmTable.name = name;
+  FBJNI_JAVAVM_FUNCTIONS(FBJNI_FAKE_JNI_INSTALL_VM)
+#undef FBJNI_FAKE_JNI_INSTALL_VM
+#define FBJNI_FAKE_JNI_INSTALL_ENV(name) envTable.name = name;
+  FBJNI_FAKE_JNIENV_FUNCTIONS(FBJNI_FAKE_JNI_INSTALL_ENV)
+#undef FBJNI_FAKE_JNI_INSTALL_ENV
+  fakeVm.functions = &vmTable;
+  fakeEnv.functions = &envTable;
+
+  attached = true;
+  Environment::initialize(&fakeVm);
+}
+
+FakeJni& FakeJni::install() {
+  static FakeJni instance;
+  return instance;
+}
+
+JavaVM* FakeJni::vm() {
+  return &fakeVm;
+}
+
+JNIEnv* FakeJni::env() {
+  return &fakeEnv;
+}
+
+size_t FakeJni::calls(JniFunction function) const {
+  return callCounts[static_cast<size_t>(function)].load(
+      std::memory_order_relaxed);
+}
+
+size_t FakeJni::totalCalls() const {
+  size_t total = 0;
+  for (const auto& calls : callCounts) {
+    total += calls.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void FakeJni::resetCalls() {
+  for (auto& calls : callCounts) {
+    calls.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t FakeJni::localRefs() const {
+  size_t refs = 0;
+  for (const auto& frame : localFrames) {
+    refs += frame.size();
+  }
+  return refs;
+}
+
+size_t FakeJni::globalRefs() const {
+  return liveGlobalRefs.load(std::memory_order_relaxed);
+}
+
+} // namespace test
+} // namespace jni
+} // namespace facebook
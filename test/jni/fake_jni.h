@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include <cstddef>
+
+#include "jni_functions.h"
+
+namespace facebook {
+namespace jni {
+namespace test {
+
+// The JNI functions the fake implements, a subset of those in
+// jni_functions.h. Calling any other function aborts with the index of its
+// slot in the function table.
+#define FBJNI_FAKE_JNIENV_FUNCTIONS(X) \
+  X(GetVersion)                        \
+  X(FindClass)                         \
+  X(GetSuperclass)                     \
+  X(IsAssignableFrom)                  \
+  X(Throw)                             \
+  X(ExceptionOccurred)                 \
+  X(ExceptionClear)                    \
+  X(PushLocalFrame)                    \
+  X(PopLocalFrame)                     \
+  X(NewGlobalRef)                      \
+  X(DeleteGlobalRef)                   \
+  X(DeleteLocalRef)                    \
+  X(IsSameObject)                      \
+  X(NewLocalRef)                       \
+  X(EnsureLocalCapacity)               \
+  X(NewObjectV)                        \
+  X(GetObjectClass)                    \
+  X(IsInstanceOf)                      \
+  X(GetMethodID)                       \
+  X(CallObjectMethodV)                 \
+  X(CallBooleanMethodV)                \
+  X(CallIntMethodV)                    \
+  X(CallLongMethodV)                   \
+  X(CallVoidMethodV)                   \
+  X(GetFieldID)                        \
+  X(GetObjectField)                    \
+  X(GetIntField)                       \
+  X(SetIntField)                       \
+  X(GetStaticMethodID)                 \
+  X(CallStaticObjectMethodV)           \
+  X(CallStaticIntMethodV)              \
+  X(CallStaticVoidMethodV)             \
+  X(GetStaticFieldID)                  \
+  X(NewString)                         \
+  X(GetStringLength)                   \
+  X(NewStringUTF)                      \
+  X(GetArrayLength)                    \
+  X(NewIntArray)                       \
+  X(GetIntArrayRegion)                 \
+  X(SetIntArrayRegion)                 \
+  X(RegisterNatives)                   \
+  X(GetStringCritical)                 \
+  X(ReleaseStringCritical)             \
+  X(NewWeakGlobalRef)                  \
+  X(DeleteWeakGlobalRef)               \
+  X(ExceptionCheck)                    \
+  X(GetObjectRefType)
+
+/**
+ * A JavaVM and JNIEnv with trivial implementations, for measuring what fbjni
+ * itself does without a JVM. Each function counts its calls. Objects are
+ * plain C++ objects: strings and int arrays keep their contents, methods
+ * return zero or null, and classes accept any object. References behave
+ * like real ones, so tests can check for leaks as well as count calls.
+ *
+ * fbjni can only be initialized once per process, so install the fake in
+ * a test binary of its own.
+ */
+class FakeJni {
+ public:
+  /// Initializes fbjni with the fake JavaVM, with the calling thread
+  /// attached. Later calls return the same instance.
+  static FakeJni& install();
+
+  JavaVM* vm();
+  JNIEnv* env();
+
+  /// Calls to function, on any thread, since the last resetCalls().
+  size_t calls(JniFunction function) const;
+  size_t totalCalls() const;
+  void resetCalls();
+
+  /// Live local references on the calling thread, in all frames.
+  size_t localRefs() const;
+  /// Live global and weak global references.
+  size_t globalRefs() const;
+
+ private:
+  FakeJni();
+};
+
+} // namespace test
+} // namespace jni
+} // namespace facebook
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fbjni/fbjni.h>
+
+#include "fake_jni.h"
+#include "jni_call_counter.h"
+
+using namespace facebook::jni;
+using namespace facebook::jni::test;
+
+namespace {
+
+class FakeJniTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    fake_ = &FakeJni::install();
+    fake_->resetCalls();
+  }
+
+  size_t calls(JniFunction function) const {
+    return fake_->calls(function);
+  }
+
+  // Leaves an exception pending, as a Java method that threw would.
+  void throwJavaException() {
+    jobject throwable = make_jstring("exception").release();
+    fake_->env()->Throw(static_cast<jthrowable>(throwable));
+  }
+
+  FakeJni* fake_;
+};
+
+} // namespace
+
+TEST_F(FakeJniTest, stringRoundTrip) {
+  size_t localRefs = fake_->localRefs();
+  {
+    auto str = make_jstring("hello");
+    EXPECT_EQ(localRefs + 1, fake_->localRefs());
+    fake_->resetCalls();
+    EXPECT_EQ("hello", str->toStdString());
+    EXPECT_EQ(1, calls(JniFunction::GetStringCritical));
+    EXPECT_EQ(1, calls(JniFunction::ReleaseStringCritical));
+  }
+  EXPECT_EQ(localRefs, fake_->localRefs());
+}
+
+TEST_F(FakeJniTest, aliasAndMoveMakeNoCalls) {
+  auto str = make_jstring("hello");
+  fake_->resetCalls();
+  alias_ref<jstring> alias = str;
+  alias_ref<jstring> copy = alias;
+  local_ref<jstring> moved = std::move(str);
+  EXPECT_EQ(copy.get(), moved.get());
+  EXPECT_EQ(0, fake_->totalCalls());
+}
+
+TEST_F(FakeJniTest, globalRefs) {
+  auto str = make_jstring("hello");
+  size_t globalRefs = fake_->globalRefs();
+  fake_->resetCalls();
+  {
+    auto global = make_global(str);
+    EXPECT_EQ(globalRefs + 1, fake_->globalRefs());
+    auto copy = global;
+  }
+  EXPECT_EQ(2, calls(JniFunction::NewGlobalRef));
+  EXPECT_EQ(2, calls(JniFunction::DeleteGlobalRef));
+  EXPECT_EQ(globalRefs, fake_->globalRefs());
+}
+
+TEST_F(FakeJniTest, localScopeReleasesRefs) {
+  size_t localRefs = fake_->localRefs();
+  {
+    JniLocalScope scope(16);
+    for (int i = 0; i < 10; ++i) {
+      make_jstring("hello").release();
+    }
+    EXPECT_EQ(localRefs + 10, fake_->localRefs());
+  }
+  EXPECT_EQ(localRefs, fake_->localRefs());
+  EXPECT_EQ(1, calls(JniFunction::PushLocalFrame));
+  EXPECT_EQ(1, calls(JniFunction::PopLocalFrame));
+  EXPECT_EQ(0, calls(JniFunction::DeleteLocalRef));
+}
+
+TEST_F(FakeJniTest, primitiveArrayRegion) {
+  auto array = JArrayInt::newArray(4);
+  jint values[] = {1, 2, 3, 4};
+  array->setRegion(0, 4, values);
+  fake_->resetCalls();
+  auto region = array->getRegion(1, 2);
+  EXPECT_EQ(2, region[0]);
+  EXPECT_EQ(3, region[1]);
+  EXPECT_EQ(1, calls(JniFunction::GetIntArrayRegion));
+}
+
+TEST_F(FakeJniTest, currentEnvironment) {
+  // Outside a native method, each call asks the VM.
+  Environment::current();
+  Environment::current();
+  EXPECT_EQ(2, calls(JniFunction::GetEnv));
+
+  // Inside one, the env passed in is cached.
+  {
+    detail::JniEnvCacher cacher(fake_->env());
+    fake_->resetCalls();
+    EXPECT_EQ(fake_->env(), Environment::current());
+    EXPECT_EQ(0, calls(JniFunction::GetEnv));
+  }
+}
+
+TEST_F(FakeJniTest, threadScopeAttaches) {
+  std::thread thread([] {
+    ThreadScope scope;
+    Environment::current();
+  });
+  thread.join();
+  EXPECT_EQ(1, calls(JniFunction::AttachCurrentThread));
+  EXPECT_EQ(1, calls(JniFunction::DetachCurrentThread));
+}
+
+TEST_F(FakeJniTest, checkedCallsFetchEnvOnce) {
+  auto cls = findClassLocal("com/facebook/jni/Fake");
+  auto method = cls->getMethod<jint()>("method");
+  auto obj = make_jstring("hello");
+  auto array = make_int_array(4);
+  jint values[4] = {};
+
+  // The exception check reuses the env the call was made with.
+  fake_->resetCalls();
+  method(obj);
+  EXPECT_EQ(1, calls(JniFunction::GetEnv));
+  EXPECT_EQ(1, calls(JniFunction::ExceptionCheck));
+
+  fake_->resetCalls();
+  array->getRegion(0, 4, values);
+  EXPECT_EQ(1, calls(JniFunction::GetEnv));
+}
+
+TEST_F(FakeJniTest, uncheckedCallsCheckOnce) {
+  auto cls = findClassLocal("com/facebook/jni/Fake");
+  auto method = cls->getMethod<jint()>("method");
+  auto obj = make_jstring("hello");
+
+  fake_->resetCalls();
+  for (int i = 0; i < 3; ++i) {
+    method(obj);
+  }
+  EXPECT_EQ(3, calls(JniFunction::CallIntMethodV));
+  EXPECT_EQ(3, calls(JniFunction::ExceptionCheck));
+
+  fake_->resetCalls();
+  {
+    UncheckedScope scope;
+    for (int i = 0; i < 3; ++i) {
+      method.unchecked(scope, obj);
+    }
+    EXPECT_EQ(0, calls(JniFunction::ExceptionCheck));
+  }
+  EXPECT_EQ(3, calls(JniFunction::CallIntMethodV));
+  EXPECT_EQ(1, calls(JniFunction::ExceptionCheck));
+}
+
+TEST_F(FakeJniTest, uncheckedScopeThrowsPendingException) {
+  auto unchecked = [this] {
+    UncheckedScope scope;
+    throwJavaException();
+  };
+  EXPECT_THROW(unchecked(), JniException);
+  EXPECT_FALSE(fake_->env()->ExceptionCheck());
+}
+
+TEST_F(FakeJniTest, uncheckedScopeClearsWhileUnwinding) {
+  try {
+    UncheckedScope scope;
+    throwJavaException();
+    throw std::runtime_error("unwinding");
+  } catch (const std::runtime_error&) {
+  }
+  EXPECT_FALSE(fake_->env()->ExceptionCheck());
+}
+
+TEST_F(FakeJniTest, callCounterMatchesFake) {
+  auto array = make_int_array(4);
+  std::vector<jint> buf(4);
+  fake_->resetCalls();
+  {
+    JniCallCounter counter;
+    array->getRegion(0, 4, buf.data());
+    array->setRegion(0, 4, buf.data());
+    EXPECT_EQ(1, counter.calls(JniFunction::GetIntArrayRegion));
+    EXPECT_EQ(1, counter.calls(JniFunction::SetIntArrayRegion));
+    // Only the JNIEnv functions are interposed, not the JavaVM ones.
+    EXPECT_EQ(
+        fake_->totalCalls() - calls(JniFunction::GetEnv),
+        counter.totalCalls())
+        << counter.summary();
+  }
+  // The counter is gone, so this call only reaches the fake.
+  array->getRegion(0, 4, buf.data());
+  EXPECT_EQ(2, calls(JniFunction::GetIntArrayRegion));
+}
+
+TEST_F(FakeJniTest, callCountersNest) {
+  JniCallCounter outer;
+  make_jstring("outer");
+  {
+    JniCallCounter inner;
+    make_jstring("inner");
+    EXPECT_EQ(1, inner.calls(JniFunction::NewStringUTF));
+  }
+  EXPECT_EQ(2, outer.calls(JniFunction::NewStringUTF));
+  EXPECT_EQ(2, calls(JniFunction::NewStringUTF));
+}
+
+// The registry lives as long as the process, so each test uses classes of
+// its own.
+TEST_F(FakeJniTest, sharedClassesAreLookedUpOnce) {
+  auto cls = detail::sharedClass("com/facebook/jni/SharedOnce");
+  EXPECT_EQ(cls, detail::sharedClass("com/facebook/jni/SharedOnce"));
+  EXPECT_EQ(1, calls(JniFunction::FindClass));
+  EXPECT_EQ(1, calls(JniFunction::NewGlobalRef));
+
+  EXPECT_NE(cls, detail::sharedClass("com/facebook/jni/SharedOther"));
+  EXPECT_EQ(2, calls(JniFunction::FindClass));
+}
+
+TEST_F(FakeJniTest, sharedIdsAreLookedUpOnce) {
+  auto cls = detail::sharedClass("com/facebook/jni/SharedIds");
+  fake_->resetCalls();
+  for (int i = 0; i < 2; ++i) {
+    detail::sharedMethodId(cls, "method", "()I", false);
+    detail::sharedMethodId(cls, "method", "()I", true);
+    detail::sharedMethodId(cls, "method", "(I)I", false);
+    detail::sharedFieldId(cls, "field", "I", false);
+    detail::sharedFieldId(cls, "field", "I", true);
+  }
+  EXPECT_EQ(2, calls(JniFunction::GetMethodID));
+  EXPECT_EQ(1, calls(JniFunction::GetStaticMethodID));
+  EXPECT_EQ(1, calls(JniFunction::GetFieldID));
+  EXPECT_EQ(1, calls(JniFunction::GetStaticFieldID));
+}
+
+TEST_F(FakeJniTest, unsharedClassIdsAreNotCached) {
+  auto cls = findClassLocal("com/facebook/jni/Unshared");
+  fake_->resetCalls();
+  detail::sharedMethodId(cls.get(), "method", "()I", false);
+  detail::sharedMethodId(cls.get(), "method", "()I", false);
+  EXPECT_EQ(2, calls(JniFunction::GetMethodID));
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,508 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fbjni/EventRing.h>
+#include <fbjni/Executor.h>
+#include <fbjni/fbjni.h>
+
+#include "embedded_jvm.h"
+
+using namespace facebook::jni;
+
+// Benchmarks of the costs of crossing the JNI boundary with fbjni, run in an
+// embedded JVM. Run with --benchmark_format=json and compare runs with
+// scripts/compare_benchmarks.py to check an fbjni upgrade for regressions.
+
+namespace {
+
+// How many calls each iteration of a Java -> C++ benchmark makes, so the
+// time of the C++ -> Java call that starts the loop is negligible.
+constexpr jint kCallsPerIteration = 1000;
+
+struct JBenchmarks : JavaClass<JBenchmarks> {
+  static constexpr auto kJavaDescriptor = "Lcom/facebook/jni/JniBenchmarks;";
+};
+
+class BenchHybrid : public HybridClass<BenchHybrid> {
+ public:
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/jni/JniBenchmarks$Hybrid;";
+
+  static void registerNatives() {
+    registerHybrid({
+        makeNativeMethod("nativeCall", BenchHybrid::call),
+    });
+  }
+
+  void call(jint i) {
+    benchmark::DoNotOptimize(last_ = i);
+  }
+
+ private:
+  jint last_ = 0;
+};
+
+void JNICALL bare(JNIEnv*, jclass, jint i) {
+  benchmark::DoNotOptimize(i);
+}
+
+void wrapped(alias_ref<jclass>, jint i) {
+  benchmark::DoNotOptimize(i);
+}
+
+void aliasRef(alias_ref<jclass>, alias_ref<jobject> obj) {
+  benchmark::DoNotOptimize(obj.get());
+}
+
+void critical(jint i) {
+  benchmark::DoNotOptimize(i);
+}
+
+void throwing(alias_ref<jclass>) {
+  throw std::runtime_error("benchmark");
+}
+
+void registerBenchmarkNatives() {
+  JBenchmarks::javaClassStatic()->registerNatives({
+      {const_cast<char*>("nativeBare"),
+       const_cast<char*>("(I)V"),
+       reinterpret_cast<void*>(bare)},
+      makeNativeMethod("nativeWrapped", wrapped),
+      makeNativeMethod("nativeAliasRef", aliasRef),
+      makeCriticalNativeMethod_DO_NOT_USE_OR_YOU_WILL_BE_FIRED(
+          "nativeCritical", critical),
+      makeNativeMethod("nativeThrow", throwing),
+  });
+  BenchHybrid::registerNatives();
+}
+
+// Runs a Java loop that makes kCallsPerIteration calls into C++.
+template <typename... Args>
+void runJavaLoop(benchmark::State& state, const char* loop, Args... args) {
+  auto cls = JBenchmarks::javaClassStatic();
+  auto method = cls->getStaticMethod<void(jint, Args...)>(loop);
+  for (auto _ : state) {
+    method(cls, kCallsPerIteration, args...);
+  }
+  state.SetItemsProcessed(state.iterations() * kCallsPerIteration);
+}
+
+void environmentCurrent(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Environment::current());
+  }
+}
+BENCHMARK(environmentCurrent);
+
+// Java -> C++, by how the native method was registered.
+
+void javaToCxxBare(benchmark::State& state) {
+  runJavaLoop(state, "callBare");
+}
+BENCHMARK(javaToCxxBare);
+
+void javaToCxxWrapped(benchmark::State& state) {
+  runJavaLoop(state, "callWrapped");
+}
+BENCHMARK(javaToCxxWrapped);
+
+void javaToCxxAliasRef(benchmark::State& state) {
+  alias_ref<jobject> obj = JBenchmarks::javaClassStatic();
+  runJavaLoop(state, "callAliasRef", obj);
+}
+BENCHMARK(javaToCxxAliasRef);
+
+void javaToCxxCritical(benchmark::State& state) {
+  runJavaLoop(state, "callCritical");
+}
+BENCHMARK(javaToCxxCritical);
+
+void javaToCxxHybrid(benchmark::State& state) {
+  auto hybrid = BenchHybrid::newObjectCxxArgs();
+  static const auto call =
+      BenchHybrid::javaClassStatic()->getMethod<void(jint)>("call");
+  for (auto _ : state) {
+    call(hybrid, kCallsPerIteration);
+  }
+  state.SetItemsProcessed(state.iterations() * kCallsPerIteration);
+}
+BENCHMARK(javaToCxxHybrid);
+
+// C++ -> Java, by arity and return type.
+
+template <typename F, typename... Args>
+void runStaticCall(benchmark::State& state, const char* name, Args... args) {
+  auto cls = JBenchmarks::javaClassStatic();
+  auto method = cls->getStaticMethod<F>(name);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(method(cls, args...));
+  }
+}
+
+void cxxToJavaNoArgs(benchmark::State& state) {
+  auto cls = JBenchmarks::javaClassStatic();
+  auto method = cls->getStaticMethod<void()>("noArgs");
+  for (auto _ : state) {
+    method(cls);
+  }
+}
+BENCHMARK(cxxToJavaNoArgs);
+
+void cxxToJavaIntArgs(benchmark::State& state) {
+  runStaticCall<jint(jint, jint, jint, jint)>(state, "intArgs", 1, 2, 3, 4);
+}
+BENCHMARK(cxxToJavaIntArgs);
+
+void cxxToJavaLongReturn(benchmark::State& state) {
+  runStaticCall<jlong()>(state, "longReturn");
+}
+BENCHMARK(cxxToJavaLongReturn);
+
+void cxxToJavaDoubleReturn(benchmark::State& state) {
+  runStaticCall<jdouble()>(state, "doubleReturn");
+}
+BENCHMARK(cxxToJavaDoubleReturn);
+
+void cxxToJavaObjectArgs(benchmark::State& state) {
+  alias_ref<jobject> obj = JBenchmarks::javaClassStatic();
+  runStaticCall<jobject(alias_ref<jobject>, alias_ref<jobject>)>(
+      state, "objectArgs", obj, obj);
+}
+BENCHMARK(cxxToJavaObjectArgs);
+
+void cxxToJavaStringReturn(benchmark::State& state) {
+  runStaticCall<jstring()>(state, "stringReturn");
+}
+BENCHMARK(cxxToJavaStringReturn);
+
+// Strings, by the kind of characters they contain: ASCII, characters in the
+// BMP that need more than one byte in UTF-8, and supplementary characters,
+// which are surrogate pairs in Java.
+
+enum ContentClass { kAscii, kBmp, kSupplementary };
+
+std::string makeString(int64_t contentClass, int64_t length) {
+  static const char* kCharacters[] = {"a", "\xe4\xb8\xad", "\xf0\x9f\x98\x80"};
+  std::string result;
+  for (int64_t i = 0; i < length; ++i) {
+    result += kCharacters[contentClass];
+  }
+  return result;
+}
+
+void stringToJava(benchmark::State& state) {
+  auto str = makeString(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(make_jstring(str));
+  }
+}
+BENCHMARK(stringToJava)
+    ->ArgNames({"content", "length"})
+    ->ArgsProduct({{kAscii, kBmp, kSupplementary}, {16, 1024}});
+
+void stringFromJava(benchmark::State& state) {
+  auto str = make_jstring(makeString(state.range(0), state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(str->toStdString());
+  }
+}
+BENCHMARK(stringFromJava)
+    ->ArgNames({"content", "length"})
+    ->ArgsProduct({{kAscii, kBmp, kSupplementary}, {16, 1024}});
+
+// Primitive arrays, by how the elements are accessed.
+
+template <typename Pinned>
+jint sum(Pinned&& pinned) {
+  jint result = 0;
+  for (size_t i = 0; i < pinned.size(); ++i) {
+    result += pinned[i];
+  }
+  return result;
+}
+
+void arrayPin(benchmark::State& state) {
+  auto array = JArrayInt::newArray(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sum(array->pin()));
+  }
+}
+BENCHMARK(arrayPin)->Arg(16)->Arg(65536);
+
+void arrayPinRegion(benchmark::State& state) {
+  auto array = JArrayInt::newArray(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sum(array->pinRegion(0, state.range(0))));
+  }
+}
+BENCHMARK(arrayPinRegion)->Arg(16)->Arg(65536);
+
+void arrayPinCritical(benchmark::State& state) {
+  auto array = JArrayInt::newArray(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sum(array->pinCritical()));
+  }
+}
+BENCHMARK(arrayPinCritical)->Arg(16)->Arg(65536);
+
+void arrayGetRegion(benchmark::State& state) {
+  auto array = JArrayInt::newArray(state.range(0));
+  for (auto _ : state) {
+    auto elements = array->getRegion(0, state.range(0));
+    jint result = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      result += elements[i];
+    }
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(arrayGetRegion)->Arg(16)->Arg(65536);
+
+// Iterating over Java collections.
+
+void iterateList(benchmark::State& state) {
+  auto cls = JBenchmarks::javaClassStatic();
+  static const auto makeList =
+      cls->getStaticMethod<JList<jobject>::javaobject(jint)>("makeList");
+  auto list = makeList(cls, state.range(0));
+  for (auto _ : state) {
+    for (const auto& element : *list) {
+      benchmark::DoNotOptimize(element.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(iterateList)->Arg(100);
+
+void iterateMap(benchmark::State& state) {
+  auto cls = JBenchmarks::javaClassStatic();
+  static const auto makeMap =
+      cls->getStaticMethod<JMap<jstring, jobject>::javaobject(jint)>(
+          "makeMap");
+  auto map = makeMap(cls, state.range(0));
+  for (auto _ : state) {
+    for (const auto& entry : *map) {
+      benchmark::DoNotOptimize(entry.first.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(iterateMap)->Arg(100);
+
+// Copying references, on several threads at once. Each iteration copies the
+// reference a few times and drops the copies, the way a callback capturing a
+// Java object gets passed around.
+
+constexpr int kCopiesPerIteration = 4;
+
+template <typename Ref>
+void runReferenceCopies(benchmark::State& state, const Ref& ref) {
+  for (auto _ : state) {
+    Ref a = ref;
+    Ref b = a;
+    Ref c = b;
+    Ref d = c;
+    benchmark::DoNotOptimize(d.get());
+  }
+  state.SetItemsProcessed(state.iterations() * kCopiesPerIteration);
+}
+
+void globalRefCopy(benchmark::State& state) {
+  ThreadScope scope;
+  static const auto ref = make_global(make_jstring("benchmark"));
+  runReferenceCopies(state, ref);
+}
+BENCHMARK(globalRefCopy)->Threads(1)->Threads(4)->Threads(8);
+
+void sharedGlobalRefCopy(benchmark::State& state) {
+  ThreadScope scope;
+  static const auto ref = make_shared_global(make_jstring("benchmark"));
+  runReferenceCopies(state, ref);
+}
+BENCHMARK(sharedGlobalRefCopy)->Threads(1)->Threads(4)->Threads(8);
+
+// Writing events to an EventRing, on several threads at once, while another
+// drains it. Compare with cxxToJavaNoArgs for the cost of a JNI call per event.
+
+void eventRingWrite(benchmark::State& state) {
+  // Shared by the benchmark's threads, and set up and torn down by the first,
+  // before the others start and after they have all finished.
+  static std::unique_ptr<EventRing> ring;
+  static std::thread consumer;
+  if (state.thread_index() == 0) {
+    ring = std::make_unique<EventRing>(1 << 20);
+    consumer = std::thread([] {
+      int64_t available = 0;
+      while (available >= 0) {
+        available = ring->awaitBatch(
+            static_cast<size_t>(available), std::chrono::milliseconds(100));
+      }
+    });
+  }
+  jlong value = 0;
+  for (auto _ : state) {
+    while (!ring->tryWrite(&value, sizeof(value))) {
+      std::this_thread::yield();
+    }
+    ++value;
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    ring->close();
+    consumer.join();
+    ring.reset();
+  }
+}
+BENCHMARK(eventRingWrite)->Threads(1)->Threads(4);
+
+// Running C++ tasks on a Java thread pool, as one batch or one execute per
+// task. Each iteration waits for all of its tasks to have run.
+
+class Countdown {
+ public:
+  void reset(int64_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    remaining_ = count;
+  }
+
+  void countDown() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--remaining_ == 0) {
+      done_.notify_all();
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return remaining_ == 0; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable done_;
+  int64_t remaining_ = 0;
+};
+
+alias_ref<JExecutor> pool() {
+  static const auto pool = [] {
+    auto cls = JBenchmarks::javaClassStatic();
+    auto makePool =
+        cls->getStaticMethod<JExecutor::javaobject(jint)>("makePool");
+    return make_global(makePool(cls, 4));
+  }();
+  return pool;
+}
+
+void executorSubmitBatch(benchmark::State& state) {
+  auto executor = pool();
+  Countdown countdown;
+  for (auto _ : state) {
+    countdown.reset(state.range(0));
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(state.range(0));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      tasks.push_back([&countdown] { countdown.countDown(); });
+    }
+    executor->submitBatch(std::move(tasks));
+    countdown.wait();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(executorSubmitBatch)->Arg(1000);
+
+void executorExecuteEach(benchmark::State& state) {
+  auto executor = pool();
+  Countdown countdown;
+  for (auto _ : state) {
+    countdown.reset(state.range(0));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      executor->execute([&countdown] { countdown.countDown(); });
+    }
+    countdown.wait();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(executorExecuteEach)->Arg(1000);
+
+// Hybrid objects.
+
+void hybridCreateDestroy(benchmark::State& state) {
+  static const auto destroy =
+      BenchHybrid::javaClassStatic()->getMethod<void()>("destroy");
+  for (auto _ : state) {
+    destroy(BenchHybrid::newObjectCxxArgs());
+  }
+}
+BENCHMARK(hybridCreateDestroy);
+
+// Exceptions, in each direction.
+
+void exceptionCxxToJava(benchmark::State& state) {
+  auto cls = JBenchmarks::javaClassStatic();
+  static const auto callThrowing =
+      cls->getStaticMethod<void(jint)>("callThrowing");
+  for (auto _ : state) {
+    callThrowing(cls, kCallsPerIteration);
+  }
+  state.SetItemsProcessed(state.iterations() * kCallsPerIteration);
+}
+BENCHMARK(exceptionCxxToJava);
+
+void exceptionJavaToCxx(benchmark::State& state) {
+  auto cls = JBenchmarks::javaClassStatic();
+  static const auto throwException =
+      cls->getStaticMethod<void()>("throwException");
+  for (auto _ : state) {
+    try {
+      throwException(cls);
+    } catch (const JniException& ex) {
+      benchmark::DoNotOptimize(&ex);
+    }
+  }
+}
+BENCHMARK(exceptionJavaToCxx);
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  try {
+    test::createEmbeddedJvm(test::defaultEmbeddedJvmOptions());
+    registerBenchmarkNatives();
+  } catch (const std::exception& ex) {
+    fprintf(stderr, "%s\n", ex.what());
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
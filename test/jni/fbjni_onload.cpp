@@ -26,6 +26,13 @@ void RegisterPrimitiveArrayTests();
 void RegisterIteratorTests();
 void RegisterByteBufferTests();
 void RegisterReadableByteChannelTests();
+void RegisterColumnarBatchTests();
+void RegisterFieldBindingTests();
+void RegisterEventRingTests();
+void RegisterCommandQueueTests();
+void RegisterCompletableFutureTests();
+void RegisterExecutorTests();
+void RegisterDynamicMethodCacheTests();
 
 jint JNI_OnLoad(JavaVM* vm, void*) {
   return facebook::jni::initialize(vm, [] {
@@ -35,5 +42,12 @@ jint JNI_OnLoad(JavaVM* vm, void*) {
     RegisterIteratorTests();
     RegisterByteBufferTests();
     RegisterReadableByteChannelTests();
+    RegisterColumnarBatchTests();
+    RegisterFieldBindingTests();
+    RegisterEventRingTests();
+    RegisterCommandQueueTests();
+    RegisterCompletableFutureTests();
+    RegisterExecutorTests();
+    RegisterDynamicMethodCacheTests();
   });
 }
@@ -19,11 +19,13 @@
 #include <stdexcept>
 #include <system_error>
 #include <thread>
+#include <vector>
 
 #include <fbjni/JThread.h>
 #include <fbjni/fbjni.h>
 
 #include "expect.h"
+#include "jni_call_counter.h"
 #include "no_rtti.h"
 
 #include "inter_dso_exception_test_2/Test.h"
@@ -236,6 +238,58 @@ void TestJMethodCallbacks(
   string_foo(callbacks);
 }
 
+void TestUncheckedCallbacks(
+    alias_ref<jobject>,
+    alias_ref<Callbacks::javaobject> callbacks) {
+  static const auto callbacks_class = Callbacks::javaClassStatic();
+  static const auto void_foo = callbacks_class->getMethod<void()>("voidFoo");
+  static const auto int_foo = callbacks_class->getMethod<jint()>("intFoo");
+  static const auto string_foo =
+      callbacks_class->getMethod<jstring()>("stringFoo");
+
+  UncheckedScope scope;
+  void_foo.unchecked(scope, callbacks);
+  int_foo.unchecked(scope, callbacks);
+  string_foo.unchecked(scope, callbacks);
+}
+
+void TestUncheckedScopeThrows(
+    alias_ref<jobject>,
+    alias_ref<Callbacks::javaobject> callbacks) {
+  static const auto void_foo =
+      Callbacks::javaClassStatic()->getMethod<void()>("voidFoo");
+  UncheckedScope scope;
+  void_foo.unchecked(scope, callbacks);
+}
+
+jboolean TestSlowCall(
+    alias_ref<jobject>,
+    alias_ref<Callbacks::javaobject> callbacks) {
+  static const auto int_foo =
+      Callbacks::javaClassStatic()->getMethod<jint()>("intFoo");
+  auto result = slowCall(int_foo.getId(), callbacks);
+  EXPECT(static_ref_cast<JInteger>(result)->value() == 0);
+
+  static const auto region_matches =
+      JString::javaClassStatic()
+          ->getMethod<jboolean(jint, alias_ref<JString>, jint, jint)>(
+              "regionMatches");
+  auto str = make_jstring("hello world");
+  auto other = make_jstring("world");
+  result = slowCall(region_matches.getId(), str, 6, other.get(), 0, 5);
+  EXPECT(static_ref_cast<JBoolean>(result)->value());
+
+  // The reflected methods and the argument array are reused.
+  facebook::jni::test::JniCallCounter counter;
+  result = slowCall(int_foo.getId(), callbacks);
+  result = slowCall(region_matches.getId(), str, 6, other.get(), 0, 5);
+  EXPECT_JNI_CALLS_LE(counter, ToReflectedMethod, 0);
+  EXPECT_JNI_CALLS_LE(counter, NewObjectArray, 0);
+  EXPECT(static_ref_cast<JBoolean>(result)->value());
+
+  return JNI_TRUE;
+}
+
 // Try to test the static functions
 void TestJStaticMethodCallbacks(JNIEnv* env, jobject self) {
   // static auto callbacks_class = findClassStatic(callbacks_class_name);
@@ -1220,6 +1274,190 @@ jboolean testAssignmentAndCopyConstructors(JNIEnv*, jobject self) {
   return JNI_TRUE;
 }
 
+jboolean testSharedGlobalRef(JNIEnv*, jobject self) {
+  using facebook::jni::internal::g_reference_stats;
+
+  g_reference_stats.reset();
+  {
+    auto shared = make_shared_global(self);
+    EXPECT(shared.use_count() == 1);
+    EXPECT(shared == self);
+
+    // Copies share the one global reference.
+    auto copy = shared;
+    shared_global_ref<JObject> reprCopy{copy};
+    EXPECT(shared.use_count() == 3);
+    EXPECT(copy == shared && reprCopy == shared);
+
+    alias_ref<jobject> alias = copy;
+    EXPECT(alias == self);
+    EXPECT(copy->isInstanceOf(alias->getClass()));
+
+    auto moved = std::move(copy);
+    EXPECT(!copy && copy.use_count() == 0);
+    EXPECT(moved.use_count() == 3);
+
+    copy = moved;
+    reprCopy.reset();
+    EXPECT(shared.use_count() == 3);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([shared] {
+        std::vector<shared_global_ref<jobject>> copies(100, shared);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT(shared.use_count() == 3);
+    EXPECT(g_reference_stats.globals_deleted == 0);
+
+    // Adopting a global_ref doesn't create a new reference.
+    shared_global_ref<jobject> adopted = make_global(self);
+    EXPECT(adopted.use_count() == 1);
+  }
+  EXPECT(g_reference_stats.globals_deleted == 2);
+
+  {
+    // Dropping the last copy on a thread that isn't attached.
+    auto shared = make_shared_global(self);
+    std::thread([copy = std::move(shared)]() mutable { copy.reset(); }).join();
+    EXPECT(!shared);
+  }
+  EXPECT(g_reference_stats.globals_deleted == 3);
+
+  return JNI_TRUE;
+}
+
+jboolean testFrameLocalRefs(JNIEnv*, jobject self) {
+  using facebook::jni::internal::g_reference_stats;
+
+  g_reference_stats.reset();
+  local_ref<JString> kept;
+  {
+    JniLocalScope scope(16);
+    scope.ensureCapacity(256);
+    for (int i = 0; i < 100; ++i) {
+      frame_local_ref<JString> str = make_jstring(std::to_string(i));
+      frame_local_ref<jobject> copy = str;
+      EXPECT(copy == str);
+    }
+    frame_local_ref<JString> last = make_jstring("last");
+    kept = scope.pop(last);
+  }
+  // Nothing was deleted one by one; the frame took care of it.
+  EXPECT(g_reference_stats.locals_deleted == 0);
+  EXPECT(kept->toStdString() == "last");
+
+  local_ref<JString> first;
+  local_ref<jobject> second;
+  {
+    JniLocalScope scope(4);
+    frame_local_ref<JString> str = make_jstring("first");
+    std::tie(first, second) = scope.pop(str, alias_ref<jobject>(self));
+  }
+  EXPECT(first->toStdString() == "first");
+  EXPECT(second == self);
+
+  return JNI_TRUE;
+}
+
+ThreadReferenceStats thisThreadsReferenceStats(
+    const ReferenceAccountingSnapshot& snapshot) {
+  for (const auto& thread : snapshot.threads) {
+    if (thread.threadId == std::this_thread::get_id()) {
+      return thread;
+    }
+  }
+  return {};
+}
+
+struct DisableReferenceAccounting {
+  ~DisableReferenceAccounting() {
+    ReferenceAccounting::disable();
+  }
+};
+
+jboolean testReferenceAccounting(JNIEnv*, jobject self) {
+  int warnings = 0;
+  std::int64_t liveLocalsAtWarning = 0;
+  ReferenceAccountingOptions options;
+  options.attributeCallSites = true;
+  options.localReferenceWarningThreshold = 50;
+  options.onLocalReferenceWarning = [&](const ThreadReferenceStats& stats) {
+    liveLocalsAtWarning = stats.liveLocals;
+    ++warnings;
+  };
+  ReferenceAccounting::enable(options);
+  // The callback refers to locals, so it must not outlive an early return.
+  DisableReferenceAccounting disableOnReturn;
+
+  {
+    std::vector<local_ref<JString>> strings;
+    for (int i = 0; i < 60; ++i) {
+      strings.push_back(make_jstring("reference"));
+    }
+    auto global = make_global(self);
+    auto weak = make_weak(self);
+    auto shared = make_shared_global(global);
+    auto sharedCopy = shared;
+
+    auto snapshot = ReferenceAccounting::snapshot();
+    auto stats = thisThreadsReferenceStats(snapshot);
+    EXPECT(stats.liveLocals == 60);
+    EXPECT(snapshot.liveGlobals == 2 && snapshot.liveWeakGlobals == 1);
+    EXPECT(warnings == 1 && liveLocalsAtWarning == 50);
+
+    bool foundSite = false;
+    for (const auto& site : snapshot.callSites) {
+      foundSite |= site.type == JNILocalRefType && site.live == 60;
+    }
+    EXPECT(foundSite);
+  }
+
+  auto snapshot = ReferenceAccounting::snapshot();
+  auto stats = thisThreadsReferenceStats(snapshot);
+  EXPECT(stats.liveLocals == 0 && stats.localsHighWater == 60);
+  EXPECT(snapshot.liveGlobals == 0 && snapshot.globalsHighWater == 2);
+  EXPECT(snapshot.liveWeakGlobals == 0 && snapshot.weakGlobalsHighWater == 1);
+  for (const auto& site : snapshot.callSites) {
+    EXPECT(site.live == 0);
+  }
+
+  // Frame references stay counted until their frame is popped.
+  {
+    JniLocalScope scope(16);
+    for (int i = 0; i < 10; ++i) {
+      frame_local_ref<JString> str = make_jstring("frame");
+    }
+    stats = thisThreadsReferenceStats(ReferenceAccounting::snapshot());
+    EXPECT(stats.liveLocals == 10);
+  }
+  stats = thisThreadsReferenceStats(ReferenceAccounting::snapshot());
+  EXPECT(stats.liveLocals == 0);
+
+  // Only references created since the last enable() are uncounted when a
+  // frame pushed before it is popped.
+  {
+    JniLocalScope scope(16);
+    std::vector<frame_local_ref<JString>> strings;
+    for (int i = 0; i < 3; ++i) {
+      strings.push_back(make_jstring("before"));
+    }
+    ReferenceAccounting::enable(options);
+    for (int i = 0; i < 2; ++i) {
+      strings.push_back(make_jstring("after"));
+    }
+    stats = thisThreadsReferenceStats(ReferenceAccounting::snapshot());
+    EXPECT(stats.liveLocals == 2);
+  }
+  stats = thisThreadsReferenceStats(ReferenceAccounting::snapshot());
+  EXPECT(stats.liveLocals == 0);
+
+  return JNI_TRUE;
+}
+
 template <template <typename> class RefType, typename T>
 static jboolean copyAndVerifyCross(RefType<T>& orig) {
   RefType<ReprType<T>> reprCopy{orig};
@@ -1595,6 +1833,11 @@ void RegisterFbjniTests() {
               "nativeTestJMethodCallbacks",
               "(Lcom/facebook/jni/FBJniTests$Callbacks;)V",
               TestJMethodCallbacks),
+          makeNativeMethod(
+              "nativeTestUncheckedCallbacks", TestUncheckedCallbacks),
+          makeNativeMethod(
+              "nativeTestUncheckedScopeThrows", TestUncheckedScopeThrows),
+          makeNativeMethod("nativeTestSlowCall", TestSlowCall),
           makeNativeMethod(
               "nativeTestJStaticMethodCallbacks", TestJStaticMethodCallbacks),
           makeNativeMethod("nativeTestIsAssignableFrom", TestIsAssignableFrom),
@@ -1616,6 +1859,10 @@ void RegisterFbjniTests() {
           makeNativeMethod(
               "nativeTestAssignmentAndCopyCrossTypes",
               testAssignmentAndCopyCrossTypes),
+          makeNativeMethod("nativeTestSharedGlobalRef", testSharedGlobalRef),
+          makeNativeMethod("nativeTestFrameLocalRefs", testFrameLocalRefs),
+          makeNativeMethod(
+              "nativeTestReferenceAccounting", testReferenceAccounting),
           makeNativeMethod("nativeTestNullReferences", testNullReferences),
           makeNativeMethod("nativeTestFieldAccess", TestFieldAccess),
           makeNativeMethod(
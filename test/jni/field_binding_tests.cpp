@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fbjni/FieldBinding.h>
+#include <fbjni/fbjni.h>
+
+#include "expect.h"
+
+using namespace facebook::jni;
+
+namespace {
+
+enum class Shape : int8_t { Circle = 1, Square = -2 };
+
+struct Point {
+  int32_t x;
+  int32_t y;
+};
+
+struct Marker {
+  int64_t id;
+  double scale;
+  bool visible;
+  Shape shape;
+  std::string label;
+  Point position;
+};
+
+struct JPoint : JavaClass<JPoint> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/jni/FieldBindingTests$Point;";
+};
+
+struct JMarker : JavaClass<JMarker> {
+  static constexpr auto kJavaDescriptor =
+      "Lcom/facebook/jni/FieldBindingTests$Marker;";
+};
+
+} // namespace
+
+namespace facebook {
+namespace jni {
+
+template <>
+struct JavaStruct<Point> {
+  using JavaType = JPoint;
+  static constexpr auto fields() {
+    return makeJavaFields(javaField("x", &Point::x), javaField("y", &Point::y));
+  }
+};
+
+template <>
+struct JavaStruct<Marker> {
+  using JavaType = JMarker;
+  static constexpr auto fields() {
+    return makeJavaFields(
+        javaField("id", &Marker::id),
+        javaField("scale", &Marker::scale),
+        javaField("visible", &Marker::visible),
+        javaField("shape", &Marker::shape),
+        javaField("label", &Marker::label),
+        javaField("position", &Marker::position));
+  }
+};
+
+} // namespace jni
+} // namespace facebook
+
+namespace {
+
+Marker makeMarker(int i) {
+  return Marker{
+      int64_t{1} << 40 | i,
+      i * 0.5,
+      i % 2 == 0,
+      i % 3 == 0 ? Shape::Circle : Shape::Square,
+      "marker" + std::to_string(i),
+      Point{i, -i}};
+}
+
+} // namespace
+
+Marker nativeMakeMarker(alias_ref<jclass>, jint i) {
+  return makeMarker(i);
+}
+
+std::vector<Marker> nativeMakeMarkers(alias_ref<jclass>, jint count) {
+  std::vector<Marker> markers;
+  for (int i = 0; i < count; ++i) {
+    markers.push_back(makeMarker(i));
+  }
+  return markers;
+}
+
+jboolean nativeTestMarker(alias_ref<jclass>, Marker marker, jint i) {
+  auto expected = makeMarker(i);
+  EXPECT(marker.id == expected.id);
+  EXPECT(marker.scale == expected.scale);
+  EXPECT(marker.visible == expected.visible);
+  EXPECT(marker.shape == expected.shape);
+  EXPECT(marker.label == expected.label);
+  EXPECT(marker.position.x == expected.position.x);
+  EXPECT(marker.position.y == expected.position.y);
+  return JNI_TRUE;
+}
+
+jboolean nativeTestMarkers(
+    alias_ref<jclass> cls,
+    std::vector<Marker> markers,
+    jint count) {
+  EXPECT(markers.size() == static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    EXPECT(nativeTestMarker(cls, markers[i], i));
+  }
+  return JNI_TRUE;
+}
+
+jboolean nativeTestNullFields(alias_ref<jclass>, Marker marker) {
+  EXPECT(marker.label.empty());
+  EXPECT(marker.position.x == 0);
+  EXPECT(marker.position.y == 0);
+  return JNI_TRUE;
+}
+
+Point nativeMidpoint(alias_ref<jclass>, Point a, Point b) {
+  return Point{(a.x + b.x) / 2, (a.y + b.y) / 2};
+}
+
+void RegisterFieldBindingTests() {
+  registerNatives(
+      "com/facebook/jni/FieldBindingTests",
+      {
+          makeNativeMethod("nativeMakeMarker", nativeMakeMarker),
+          makeNativeMethod("nativeMakeMarkers", nativeMakeMarkers),
+          makeNativeMethod("nativeTestMarker", nativeTestMarker),
+          makeNativeMethod("nativeTestMarkers", nativeTestMarkers),
+          makeNativeMethod("nativeTestNullFields", nativeTestNullFields),
+          makeNativeMethod("nativeMidpoint", nativeMidpoint),
+      });
+}
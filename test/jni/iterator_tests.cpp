@@ -19,11 +19,14 @@
 #include <unordered_set>
 #include <vector>
 
+#include <fbjni/NativeCollections.h>
 #include <fbjni/fbjni.h>
 
 #include "expect.h"
+#include "jni_call_counter.h"
 
 using namespace facebook::jni;
+using facebook::jni::test::JniCallCounter;
 
 jboolean nativeTestListIterator(
     alias_ref<jclass>,
@@ -168,6 +171,211 @@ jboolean nativeTestLargeMapIteration(
   return JNI_TRUE;
 }
 
+jboolean nativeTestBatchBoundaries(
+    alias_ref<jclass>,
+    alias_ref<JList<JInteger>> jlist,
+    alias_ref<JMap<JInteger, jobject>> jmap) {
+  EXPECT(jlist);
+  EXPECT(jmap);
+
+  // The list holds 0..size-1 in order, which must come back out in order
+  // however the batches fall.
+  int expected = 0;
+  for (const auto& elem : *jlist) {
+    EXPECT(elem->intValue() == expected);
+    ++expected;
+  }
+  EXPECT(expected == static_cast<int>(jlist->size()));
+
+  // Values are read back as plain jobjects, which skips the element cast.
+  std::unordered_set<int> keys;
+  for (const auto& entry : *jmap) {
+    EXPECT(entry.second);
+    keys.insert(entry.first->intValue());
+  }
+  EXPECT(keys.size() == jmap->size());
+
+  // A copied iterator shares its batch with the original, and the original
+  // keeps going once the copy is gone.
+  auto it = jlist->begin();
+  expected = 0;
+  if (it != jlist->end()) {
+    auto copy = it++;
+    EXPECT((*copy)->intValue() == 0);
+    expected = 1;
+  }
+  for (; it != jlist->end(); ++it) {
+    EXPECT((*it)->intValue() == expected);
+    ++expected;
+  }
+  EXPECT(expected == static_cast<int>(jlist->size()));
+
+  // A copy keeps reading the batch it was copied with, even after the original
+  // has moved on and refilled.
+  if (jlist->size() > static_cast<size_t>(detail::kIteratorBatchSize)) {
+    auto original = jlist->begin();
+    auto copy = original;
+    for (jint i = 0; i < detail::kIteratorBatchSize; ++i) {
+      ++original;
+    }
+    EXPECT((*original)->intValue() == detail::kIteratorBatchSize);
+    for (jint i = 1; i < detail::kIteratorBatchSize; ++i) {
+      ++copy;
+      EXPECT((*copy)->intValue() == i);
+    }
+  }
+
+  return JNI_TRUE;
+}
+
+// Walking a collection should cost one call per batch to refill it, plus a
+// call per element to read it out of the batch and another to check its type.
+jboolean nativeTestIterationCallBudget(
+    alias_ref<jclass>,
+    alias_ref<JList<JInteger>> jlist,
+    alias_ref<JMap<JInteger, jobject>> jmap) {
+  size_t size = jlist->size();
+  size_t batches = size / detail::kIteratorBatchSize + 1;
+
+  // Looks up the helper classes and methods, which is done once.
+  for (const auto& elem : *jlist) {
+    (void)elem;
+  }
+  for (const auto& entry : *jmap) {
+    (void)entry;
+  }
+
+  {
+    JniCallCounter counter;
+    size_t count = 0;
+    for (const auto& elem : *jlist) {
+      (void)elem;
+      ++count;
+    }
+    EXPECT(count == size);
+    EXPECT_JNI_CALLS_LE(counter, CallIntMethodV, batches);
+    EXPECT_JNI_CALLS_LE(counter, GetObjectArrayElement, size);
+    EXPECT_JNI_CALLS_LE(counter, IsInstanceOf, size);
+  }
+
+  {
+    size_t mapSize = jmap->size();
+    JniCallCounter counter;
+    size_t count = 0;
+    for (const auto& entry : *jmap) {
+      (void)entry;
+      ++count;
+    }
+    EXPECT(count == mapSize);
+    EXPECT_JNI_CALLS_LE(
+        counter, CallIntMethodV, mapSize / detail::kIteratorBatchSize + 1);
+    // Values are plain jobjects, so only the keys are checked.
+    EXPECT_JNI_CALLS_LE(counter, GetObjectArrayElement, 2 * mapSize);
+    EXPECT_JNI_CALLS_LE(counter, IsInstanceOf, mapSize);
+  }
+
+  return JNI_TRUE;
+}
+
+jboolean nativeTestToUnorderedMap(
+    alias_ref<jclass>,
+    alias_ref<JMap<jstring, JInteger>> jcounts,
+    alias_ref<JMap<jstring, jstring>> jnames) {
+  auto counts = toUnorderedMap(
+      jcounts, [](alias_ref<JInteger> count) { return count->intValue(); });
+  EXPECT(counts.size() == 3);
+  EXPECT(counts["one"] == 1);
+  EXPECT(counts["two"] == 2);
+  EXPECT(counts[""] == 0);
+
+  auto names = toUnorderedMap(jnames);
+  EXPECT(names.size() == 3);
+  EXPECT(names["ascii"] == "plain");
+  EXPECT(names["\xC3\xA9t\xC3\xA9"] == "\xE2\x82\xAC");
+  EXPECT(names["\xF0\x9F\x98\x80"] == "");
+
+  return JNI_TRUE;
+}
+
+local_ref<JMap<jstring, JInteger>> nativeToJavaHashMap(alias_ref<jclass>) {
+  std::unordered_map<std::string, int> counts = {
+      {"one", 1}, {"\xF0\x9F\x98\x80", 2}, {"", 3}};
+  return toJavaHashMap<JInteger>(
+      counts, [](int count) { return JInteger::valueOf(count); });
+}
+
+local_ref<JMap<jstring, jstring>> nativeToJavaStringHashMap(alias_ref<jclass>) {
+  std::unordered_map<std::string, std::string> names = {
+      {"ascii", "plain"},
+      {"\xC3\xA9t\xC3\xA9", "\xE2\x82\xAC"},
+      {"empty", ""}};
+  return toJavaHashMap(names);
+}
+
+jboolean nativeTestListRandomAccess(
+    alias_ref<jclass>,
+    alias_ref<JList<jstring>> jlist) {
+  EXPECT(jlist->size() == 5);
+  EXPECT(jlist->get(0)->toStdString() == "zero");
+  EXPECT(jlist->get(4)->toStdString() == "four");
+
+  auto old = jlist->set(2, make_jstring("TWO"));
+  EXPECT(static_ref_cast<jstring>(old)->toStdString() == "two");
+  EXPECT(jlist->get(2)->toStdString() == "TWO");
+
+  auto middle = jlist->subList(1, 4);
+  EXPECT(middle->size() == 3);
+  EXPECT(middle->get(0)->toStdString() == "one");
+
+  auto array = jlist->toArray();
+  EXPECT(array->size() == 5);
+  EXPECT(
+      static_ref_cast<jstring>(array->getElement(3))->toStdString() ==
+      "three");
+
+  auto refs = jlist->copyRange(1, 3);
+  EXPECT(refs.size() == 2);
+  EXPECT(refs[0]->toStdString() == "one");
+  EXPECT(refs[1]->toStdString() == "TWO");
+
+  auto lengths = jlist->copyRange(
+      0, 5, [](local_ref<jstring> s) { return s->toStdString().size(); });
+  EXPECT((lengths == std::vector<size_t>{4, 3, 3, 5, 4}));
+
+  EXPECT(jlist->copyRange(5, 5).empty());
+
+  auto strings = toStringVector(jlist, 2, 5);
+  EXPECT((strings == std::vector<std::string>{"TWO", "three", "four"}));
+  EXPECT(toStringVector(jlist).size() == 5);
+
+  return JNI_TRUE;
+}
+
+local_ref<JList<>> nativeCreateNativeList(alias_ref<jclass>, jint size) {
+  std::vector<std::string> names;
+  for (int i = 0; i < size; ++i) {
+    names.push_back("name" + std::to_string(i));
+  }
+  return JNativeList::create(std::move(names));
+}
+
+local_ref<JList<>> nativeCreateConvertedNativeList(alias_ref<jclass>) {
+  std::vector<int> values = {1, 2, 3};
+  return JNativeList::create(
+      values, [](int value) { return JInteger::valueOf(value * 10); });
+}
+
+local_ref<JMap<>> nativeCreateNativeMap(alias_ref<jclass>) {
+  std::unordered_map<std::string, std::string> names = {
+      {"one", "uno"}, {"two", "dos"}, {"three", "tres"}};
+  return JNativeMap::create(std::move(names));
+}
+
+local_ref<JMap<>> nativeCreateIntKeyedNativeMap(alias_ref<jclass>) {
+  std::unordered_map<int, double> values = {{1, 1.5}, {2, 2.5}};
+  return JNativeMap::create(std::move(values));
+}
+
 void RegisterIteratorTests() {
   registerNatives(
       "com/facebook/jni/IteratorTests",
@@ -180,5 +388,23 @@ void RegisterIteratorTests() {
               "nativeTestIterateNullKey", nativeTestIterateNullKey),
           makeNativeMethod(
               "nativeTestLargeMapIteration", nativeTestLargeMapIteration),
+          makeNativeMethod(
+              "nativeTestBatchBoundaries", nativeTestBatchBoundaries),
+          makeNativeMethod(
+              "nativeTestIterationCallBudget", nativeTestIterationCallBudget),
+          makeNativeMethod(
+              "nativeTestToUnorderedMap", nativeTestToUnorderedMap),
+          makeNativeMethod("nativeToJavaHashMap", nativeToJavaHashMap),
+          makeNativeMethod(
+              "nativeTestListRandomAccess", nativeTestListRandomAccess),
+          makeNativeMethod("nativeCreateNativeList", nativeCreateNativeList),
+          makeNativeMethod(
+              "nativeCreateConvertedNativeList",
+              nativeCreateConvertedNativeList),
+          makeNativeMethod("nativeCreateNativeMap", nativeCreateNativeMap),
+          makeNativeMethod(
+              "nativeCreateIntKeyedNativeMap", nativeCreateIntKeyedNativeMap),
+          makeNativeMethod(
+              "nativeToJavaStringHashMap", nativeToJavaStringHashMap),
       });
 }
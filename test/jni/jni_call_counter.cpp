@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jni_call_counter.h"
+
+#include <fbjni/fbjni.h>
+
+namespace facebook {
+namespace jni {
+namespace test {
+
+namespace {
+
+thread_local JniCallCounter* activeCounter = nullptr;
+
+} // namespace
+
+template <typename R, typename... Args>
+struct JniCallCounter::Thunk<R(JNICALL*)(JNIEnv*, Args...)> {
+  template <JniFunction F, R(JNICALL* Table::*Slot)(JNIEnv*, Args...)>
+  static R JNICALL call(JNIEnv* env, Args... args) {
+    // Every counter on this thread sees the call; the outermost one holds
+    // the table that was there before any of them.
+    const Table* original = nullptr;
+    for (auto counter = activeCounter; counter; counter = counter->outer_) {
+      ++counter->counts_[static_cast<size_t>(F)];
+      original = counter->original_;
+    }
+    return (original->*Slot)(env, args...);
+  }
+};
+
+JniCallCounter::JniCallCounter()
+    : env_(Environment::current()),
+      outer_(activeCounter),
+      original_(env_->functions),
+      table_(*env_->functions) {
+#define FBJNI_JNI_CALL_COUNTER_THUNK(name)                            \
+  table_.name = &Thunk<decltype(table_.name)>::template call<         \
+      JniFunction::name,                                              \
+      &Table::name>;
+  FBJNI_JNIENV_FUNCTIONS(FBJNI_JNI_CALL_COUNTER_THUNK)
+#undef FBJNI_JNI_CALL_COUNTER_THUNK
+  activeCounter = this;
+  env_->functions = &table_;
+}
+
+JniCallCounter::~JniCallCounter() {
+  FBJNI_ASSERT(activeCounter == this);
+  activeCounter = outer_;
+  env_->functions = original_;
+}
+
+size_t JniCallCounter::totalCalls() const {
+  size_t total = 0;
+  for (auto count : counts_) {
+    total += count;
+  }
+  return total;
+}
+
+void JniCallCounter::reset() {
+  counts_.fill(0);
+}
+
+std::string JniCallCounter::summary() const {
+  std::string result;
+  for (size_t i = 0; i < kJniFunctionCount; ++i) {
+    if (counts_[i] == 0) {
+      continue;
+    }
+    if (!result.empty()) {
+      result += ", ";
+    }
+    result += jniFunctionName(static_cast<JniFunction>(i));
+    result += '=';
+    result += std::to_string(counts_[i]);
+  }
+  return result.empty() ? "no JNI calls" : result;
+}
+
+} // namespace test
+} // namespace jni
+} // namespace facebook
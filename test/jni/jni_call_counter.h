@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fbjni/detail/Log.h>
+
+#include "jni_functions.h"
+
+namespace facebook {
+namespace jni {
+namespace test {
+
+/**
+ * Counts the JNI functions called on the current thread while it is alive,
+ * so tests can put a budget on how often an fbjni operation crosses into
+ * the VM. It swaps the function table of the thread's JNIEnv for one that
+ * counts each call and forwards it to the original, and puts the original
+ * back when destroyed.
+ *
+ * Only the thread that creates the counter is counted. Counters may nest,
+ * in which case every active counter sees each call; destroy them in the
+ * reverse order of creation. The variadic functions are not interposed,
+ * but fbjni only uses the V versions.
+ */
+class JniCallCounter {
+ public:
+  JniCallCounter();
+  ~JniCallCounter();
+
+  JniCallCounter(const JniCallCounter&) = delete;
+  JniCallCounter& operator=(const JniCallCounter&) = delete;
+
+  size_t calls(JniFunction function) const {
+    return counts_[static_cast<size_t>(function)];
+  }
+  size_t totalCalls() const;
+  void reset();
+
+  /// The functions that were called, with their counts, for failure
+  /// messages.
+  std::string summary() const;
+
+ private:
+  using Table = typename std::remove_const<typename std::remove_pointer<
+      decltype(std::declval<JNIEnv&>().functions)>::type>::type;
+
+  template <typename Fn>
+  struct Thunk;
+
+  JNIEnv* env_;
+  JniCallCounter* outer_;
+  const Table* original_;
+  Table table_;
+  std::array<size_t, kJniFunctionCount> counts_{};
+};
+
+} // namespace test
+} // namespace jni
+} // namespace facebook
+
+/// For tests that report through expect.h: fails unless counter has seen
+/// at most n calls to function.
+#define EXPECT_JNI_CALLS_LE(counter, function, n)                       \
+  do {                                                                  \
+    size_t fbjniCalls_ = (counter).calls(                               \
+        ::facebook::jni::test::JniFunction::function);                  \
+    if (fbjniCalls_ > static_cast<size_t>(n)) {                         \
+      FBJNI_LOGE(                                                       \
+          "[%s:%d] Expected at most %zu calls to %s, got %zu: %s",      \
+          __FILE__,                                                     \
+          __LINE__,                                                     \
+          static_cast<size_t>(n),                                       \
+          #function,                                                    \
+          fbjniCalls_,                                                  \
+          (counter).summary().c_str());                                 \
+      return JNI_FALSE;                                                 \
+    }                                                                   \
+  } while (false)
+
+/// Like EXPECT_JNI_CALLS_LE, for the calls to all functions together.
+#define EXPECT_TOTAL_JNI_CALLS_LE(counter, n)                           \
+  do {                                                                  \
+    size_t fbjniCalls_ = (counter).totalCalls();                        \
+    if (fbjniCalls_ > static_cast<size_t>(n)) {                         \
+      FBJNI_LOGE(                                                       \
+          "[%s:%d] Expected at most %zu JNI calls, got %zu: %s",        \
+          __FILE__,                                                     \
+          __LINE__,                                                     \
+          static_cast<size_t>(n),                                       \
+          fbjniCalls_,                                                  \
+          (counter).summary().c_str());                                 \
+      return JNI_FALSE;                                                 \
+    }                                                                   \
+  } while (false)
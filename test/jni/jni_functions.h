@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace facebook {
+namespace jni {
+namespace test {
+
+// The JavaVM functions, and the JNIEnv functions of JNI 1.6 except the
+// variadic ones. The C++ JNIEnv methods that fbjni calls forward to the V
+// versions, so those are the ones that show up in counts.
+#define FBJNI_JAVAVM_FUNCTIONS(X) \
+  X(DestroyJavaVM)                \
+  X(AttachCurrentThread)          \
+  X(DetachCurrentThread)          \
+  X(GetEnv)                       \
+  X(AttachCurrentThreadAsDaemon)
+
+#define FBJNI_JNIENV_FUNCTIONS(X)  \
+  X(GetVersion)                    \
+  X(DefineClass)                   \
+  X(FindClass)                     \
+  X(FromReflectedMethod)           \
+  X(FromReflectedField)            \
+  X(ToReflectedMethod)             \
+  X(GetSuperclass)                 \
+  X(IsAssignableFrom)              \
+  X(ToReflectedField)              \
+  X(Throw)                         \
+  X(ThrowNew)                      \
+  X(ExceptionOccurred)             \
+  X(ExceptionDescribe)             \
+  X(ExceptionClear)                \
+  X(FatalError)                    \
+  X(PushLocalFrame)                \
+  X(PopLocalFrame)                 \
+  X(NewGlobalRef)                  \
+  X(DeleteGlobalRef)               \
+  X(DeleteLocalRef)                \
+  X(IsSameObject)                  \
+  X(NewLocalRef)                   \
+  X(EnsureLocalCapacity)           \
+  X(AllocObject)                   \
+  X(NewObjectV)                    \
+  X(NewObjectA)                    \
+  X(GetObjectClass)                \
+  X(IsInstanceOf)                  \
+  X(GetMethodID)                   \
+  X(CallObjectMethodV)             \
+  X(CallObjectMethodA)             \
+  X(CallBooleanMethodV)            \
+  X(CallBooleanMethodA)            \
+  X(CallByteMethodV)               \
+  X(CallByteMethodA)               \
+  X(CallCharMethodV)               \
+  X(CallCharMethodA)               \
+  X(CallShortMethodV)              \
+  X(CallShortMethodA)              \
+  X(CallIntMethodV)                \
+  X(CallIntMethodA)                \
+  X(CallLongMethodV)               \
+  X(CallLongMethodA)               \
+  X(CallFloatMethodV)              \
+  X(CallFloatMethodA)              \
+  X(CallDoubleMethodV)             \
+  X(CallDoubleMethodA)             \
+  X(CallVoidMethodV)               \
+  X(CallVoidMethodA)               \
+  X(CallNonvirtualObjectMethodV)   \
+  X(CallNonvirtualObjectMethodA)   \
+  X(CallNonvirtualBooleanMethodV)  \
+  X(CallNonvirtualBooleanMethodA)  \
+  X(CallNonvirtualByteMethodV)     \
+  X(CallNonvirtualByteMethodA)     \
+  X(CallNonvirtualCharMethodV)     \
+  X(CallNonvirtualCharMethodA)     \
+  X(CallNonvirtualShortMethodV)    \
+  X(CallNonvirtualShortMethodA)    \
+  X(CallNonvirtualIntMethodV)      \
+  X(CallNonvirtualIntMethodA)      \
+  X(CallNonvirtualLongMethodV)     \
+  X(CallNonvirtualLongMethodA)     \
+  X(CallNonvirtualFloatMethodV)    \
+  X(CallNonvirtualFloatMethodA)    \
+  X(CallNonvirtualDoubleMethodV)   \
+  X(CallNonvirtualDoubleMethodA)   \
+  X(CallNonvirtualVoidMethodV)     \
+  X(CallNonvirtualVoidMethodA)     \
+  X(GetFieldID)                    \
+  X(GetObjectField)                \
+  X(GetBooleanField)               \
+  X(GetByteField)                  \
+  X(GetCharField)                  \
+  X(GetShortField)                 \
+  X(GetIntField)                   \
+  X(GetLongField)                  \
+  X(GetFloatField)                 \
+  X(GetDoubleField)                \
+  X(SetObjectField)                \
+  X(SetBooleanField)               \
+  X(SetByteField)                  \
+  X(SetCharField)                  \
+  X(SetShortField)                 \
+  X(SetIntField)                   \
+  X(SetLongField)                  \
+  X(SetFloatField)                 \
+  X(SetDoubleField)                \
+  X(GetStaticMethodID)             \
+  X(CallStaticObjectMethodV)       \
+  X(CallStaticObjectMethodA)       \
+  X(CallStaticBooleanMethodV)      \
+  X(CallStaticBooleanMethodA)      \
+  X(CallStaticByteMethodV)         \
+  X(CallStaticByteMethodA)         \
+  X(CallStaticCharMethodV)         \
+  X(CallStaticCharMethodA)         \
+  X(CallStaticShortMethodV)        \
+  X(CallStaticShortMethodA)        \
+  X(CallStaticIntMethodV)          \
+  X(CallStaticIntMethodA)          \
+  X(CallStaticLongMethodV)         \
+  X(CallStaticLongMethodA)         \
+  X(CallStaticFloatMethodV)        \
+  X(CallStaticFloatMethodA)        \
+  X(CallStaticDoubleMethodV)       \
+  X(CallStaticDoubleMethodA)       \
+  X(CallStaticVoidMethodV)         \
+  X(CallStaticVoidMethodA)         \
+  X(GetStaticFieldID)              \
+  X(GetStaticObjectField)          \
+  X(GetStaticBooleanField)         \
+  X(GetStaticByteField)            \
+  X(GetStaticCharField)            \
+  X(GetStaticShortField)           \
+  X(GetStaticIntField)             \
+  X(GetStaticLongField)            \
+  X(GetStaticFloatField)           \
+  X(GetStaticDoubleField)          \
+  X(SetStaticObjectField)          \
+  X(SetStaticBooleanField)         \
+  X(SetStaticByteField)            \
+  X(SetStaticCharField)            \
+  X(SetStaticShortField)           \
+  X(SetStaticIntField)             \
+  X(SetStaticLongField)            \
+  X(SetStaticFloatField)           \
+  X(SetStaticDoubleField)          \
+  X(NewString)                     \
+  X(GetStringLength)               \
+  X(GetStringChars)                \
+  X(ReleaseStringChars)            \
+  X(NewStringUTF)                  \
+  X(GetStringUTFLength)            \
+  X(GetStringUTFChars)             \
+  X(ReleaseStringUTFChars)         \
+  X(GetArrayLength)                \
+  X(NewObjectArray)                \
+  X(GetObjectArrayElement)         \
+  X(SetObjectArrayElement)         \
+  X(NewBooleanArray)               \
+  X(NewByteArray)                  \
+  X(NewCharArray)                  \
+  X(NewShortArray)                 \
+  X(NewIntArray)                   \
+  X(NewLongArray)                  \
+  X(NewFloatArray)                 \
+  X(NewDoubleArray)                \
+  X(GetBooleanArrayElements)       \
+  X(GetByteArrayElements)          \
+  X(GetCharArrayElements)          \
+  X(GetShortArrayElements)         \
+  X(GetIntArrayElements)           \
+  X(GetLongArrayElements)          \
+  X(GetFloatArrayElements)         \
+  X(GetDoubleArrayElements)        \
+  X(ReleaseBooleanArrayElements)   \
+  X(ReleaseByteArrayElements)      \
+  X(ReleaseCharArrayElements)      \
+  X(ReleaseShortArrayElements)     \
+  X(ReleaseIntArrayElements)       \
+  X(ReleaseLongArrayElements)      \
+  X(ReleaseFloatArrayElements)     \
+  X(ReleaseDoubleArrayElements)    \
+  X(GetBooleanArrayRegion)         \
+  X(GetByteArrayRegion)            \
+  X(GetCharArrayRegion)            \
+  X(GetShortArrayRegion)           \
+  X(GetIntArrayRegion)             \
+  X(GetLongArrayRegion)            \
+  X(GetFloatArrayRegion)           \
+  X(GetDoubleArrayRegion)          \
+  X(SetBooleanArrayRegion)         \
+  X(SetByteArrayRegion)            \
+  X(SetCharArrayRegion)            \
+  X(SetShortArrayRegion)           \
+  X(SetIntArrayRegion)             \
+  X(SetLongArrayRegion)            \
+  X(SetFloatArrayRegion)           \
+  X(SetDoubleArrayRegion)          \
+  X(RegisterNatives)               \
+  X(UnregisterNatives)             \
+  X(MonitorEnter)                  \
+  X(MonitorExit)                   \
+  X(GetJavaVM)                     \
+  X(GetStringRegion)               \
+  X(GetStringUTFRegion)            \
+  X(GetPrimitiveArrayCritical)     \
+  X(ReleasePrimitiveArrayCritical) \
+  X(GetStringCritical)             \
+  X(ReleaseStringCritical)         \
+  X(NewWeakGlobalRef)              \
+  X(DeleteWeakGlobalRef)           \
+  X(ExceptionCheck)                \
+  X(NewDirectByteBuffer)           \
+  X(GetDirectBufferAddress)        \
+  X(GetDirectBufferCapacity)       \
+  X(GetObjectRefType)
+
+enum class JniFunction {
+#define FBJNI_JNI_FUNCTION_ENUMERATOR(name) name,
+  FBJNI_JAVAVM_FUNCTIONS(FBJNI_JNI_FUNCTION_ENUMERATOR)
+      FBJNI_JNIENV_FUNCTIONS(FBJNI_JNI_FUNCTION_ENUMERATOR)
+#undef FBJNI_JNI_FUNCTION_ENUMERATOR
+};
+
+#define FBJNI_JNI_FUNCTION_COUNT(name) +1
+constexpr size_t kJniFunctionCount = 0 FBJNI_JAVAVM_FUNCTIONS(
+    FBJNI_JNI_FUNCTION_COUNT) FBJNI_JNIENV_FUNCTIONS(FBJNI_JNI_FUNCTION_COUNT);
+#undef FBJNI_JNI_FUNCTION_COUNT
+
+inline const char* jniFunctionName(JniFunction function) {
+  static const char* kNames[] = {
+#define FBJNI_JNI_FUNCTION_NAME(name) #name,
+      FBJNI_JAVAVM_FUNCTIONS(FBJNI_JNI_FUNCTION_NAME)
+          FBJNI_JNIENV_FUNCTIONS(FBJNI_JNI_FUNCTION_NAME)
+#undef FBJNI_JNI_FUNCTION_NAME
+  };
+  return kNames[static_cast<size_t>(function)];
+}
+
+} // namespace test
+} // namespace jni
+} // namespace facebook
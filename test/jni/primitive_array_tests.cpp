@@ -20,8 +20,10 @@
 #include <fbjni/fbjni.h>
 
 #include "expect.h"
+#include "jni_call_counter.h"
 
 using namespace facebook::jni;
+using facebook::jni::test::JniCallCounter;
 
 local_ref<jbooleanArray> testMakeBoolArray(alias_ref<jclass>, jint size) {
   return make_boolean_array(size);
@@ -296,6 +298,45 @@ jboolean testNonCopiedPinnedArray(
   return JNI_TRUE;
 }
 
+// Each of these should cross into the VM once, plus the exception check.
+jboolean testIntArrayCallBudget(
+    alias_ref<jclass>,
+    alias_ref<jintArray> array) {
+  jsize size = array->size();
+  EXPECT(size > 0);
+  std::vector<jint> buf(size);
+
+  {
+    JniCallCounter counter;
+    array->getRegion(0, size, buf.data());
+    EXPECT_JNI_CALLS_LE(counter, GetIntArrayRegion, 1);
+    EXPECT_TOTAL_JNI_CALLS_LE(counter, 2);
+  }
+
+  {
+    JniCallCounter counter;
+    array->setRegion(0, size, buf.data());
+    EXPECT_JNI_CALLS_LE(counter, SetIntArrayRegion, 1);
+    EXPECT_TOTAL_JNI_CALLS_LE(counter, 2);
+  }
+
+  {
+    JniCallCounter counter;
+    {
+      auto pin = array->pin();
+      for (size_t i = 0; i < pin.size(); ++i) {
+        pin[i] += 1;
+      }
+    }
+    EXPECT_JNI_CALLS_LE(counter, GetIntArrayElements, 1);
+    EXPECT_JNI_CALLS_LE(counter, GetArrayLength, 1);
+    EXPECT_JNI_CALLS_LE(counter, ReleaseIntArrayElements, 1);
+    EXPECT_TOTAL_JNI_CALLS_LE(counter, 5);
+  }
+
+  return JNI_TRUE;
+}
+
 void RegisterPrimitiveArrayTests() {
   registerNatives(
       "com/facebook/jni/PrimitiveArrayTests",
@@ -395,5 +436,7 @@ void RegisterPrimitiveArrayTests() {
               "nativeTestCopiedPinnedArray", testCopiedPinnedArray),
           makeNativeMethod(
               "nativeTestNonCopiedPinnedArray", testNonCopiedPinnedArray),
+          makeNativeMethod(
+              "nativeTestIntArrayCallBudget", testIntArrayCallBudget),
       });
 }
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fbjni/detail/utf8.h>
+
+using namespace std;
+using namespace facebook::jni;
+
+namespace {
+
+std::u16string toUTF16(const std::string& utf8) {
+  std::u16string out;
+  detail::utf8toUTF16(
+      reinterpret_cast<const uint8_t*>(utf8.data()), utf8.size(), out);
+  return out;
+}
+
+} // namespace
+
+TEST(Utf8toUTF16_test, emptyUtf8String) {
+  EXPECT_TRUE(toUTF16("").empty());
+}
+
+TEST(Utf8toUTF16_test, appendsToOutput) {
+  std::u16string out = u"ab";
+  detail::utf8toUTF16(reinterpret_cast<const uint8_t*>("cd"), 2, out);
+  EXPECT_EQ(out, u"abcd");
+}
+
+TEST(Utf8toUTF16_test, goodUtf8String) {
+  auto utf16String = toUTF16("a\xC4\xA3\xE1\x88\xB4\xF0\x94\xA0\xB4");
+  EXPECT_EQ(
+      utf16String, (std::u16string{u'a', 0x0123, 0x1234, 0xD812, 0xDC34}));
+}
+
+TEST(Utf8toUTF16_test, embeddedNul) {
+  auto utf16String = toUTF16(std::string("a\0b", 3));
+  EXPECT_EQ(utf16String, (std::u16string{u'a', 0, u'b'}));
+}
+
+TEST(Utf8toUTF16_test, roundTripsThroughUtf16toUTF8) {
+  std::string utf8String = "x\xC4\xA3y\xE1\x88\xB4z\xF0\x94\xA0\xB4";
+  auto utf16String = toUTF16(utf8String);
+  EXPECT_EQ(
+      detail::utf16toUTF8(
+          reinterpret_cast<const uint16_t*>(utf16String.data()),
+          utf16String.size()),
+      utf8String);
+}
+
+TEST(Utf8toUTF16_test, badFormedUtf8String) {
+  // A stray continuation byte, and a truncated 3 byte sequence followed by a
+  // valid character.
+  auto utf16String = toUTF16("a\x80" "b\xE1\x88" "c");
+  EXPECT_EQ(utf16String, (std::u16string{u'a', 0xFFFD, u'b', 0xFFFD, u'c'}));
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}